@@ -91,6 +91,11 @@ AppModel::AppModel(WalletSettings& settings)
 {
     assert(s_instance == nullptr);
     s_instance = this;
+    m_eventMonitor.startDump(QDir(QString::fromStdString(m_settings.getAppDataPath())).filePath(WalletSettings::LogsFolder));
+    if (const auto stallThreshold = m_settings.getStallThreshold(); stallThreshold > 0)
+    {
+        m_stallWatchdog = std::make_unique<StallWatchdog>(stallThreshold);
+    }
     m_nodeModel.start();
 }
 
@@ -104,6 +109,9 @@ void AppModel::backupDB(const std::string& dbFilePath)
     const auto wasInitialized = WalletDB::isInitialized(dbFilePath);
     m_db.reset();
 
+    // the asset cache belongs to the wallet which is going away
+    fsutils::remove(m_settings.getAssetsCacheStorage());
+
     if (wasInitialized)
     {
         // it seems that we are trying to restore or login to another wallet.
@@ -304,12 +312,17 @@ void AppModel::onResetWallet()
     assert(m_wallet.use_count() == 1);
     assert(m_db);
 
+#if defined(BEAM_UI_PROFILING)
+    m_syntheticLoad.reset();
+    m_callbackReplay.reset();
+#endif
     m_wallet.reset();
     resetSwapClients();
 
     m_db.reset();
 
     fsutils::remove(getSettings().getWalletStorage());
+    fsutils::remove(getSettings().getAssetsCacheStorage());
 
 #if defined(BEAM_HW_WALLET)
     fsutils::remove(getSettings().getTrezorWalletStorage());
@@ -324,6 +337,14 @@ void AppModel::onResetWallet()
 
 void AppModel::startWallet()
 {
+#if defined(BEAM_UI_PROFILING)
+    if (m_callbackReplay || m_syntheticLoad)
+    {
+        // wallet events come from the trace or the generator, settings changes must not start the client
+        return;
+    }
+#endif
+
     assert(!m_wallet->isRunning());
 
     auto additionalTxCreators = std::make_shared<std::unordered_map<TxType, BaseTransaction::Creator::Ptr>>();
@@ -459,6 +480,24 @@ void AppModel::start()
 
     m_wallet = std::make_shared<WalletModel>(m_db, nodeAddrStr, m_walletReactor);
 
+#if defined(BEAM_UI_PROFILING)
+    if (const auto recordPath = m_settings.getCallbackRecordPath(); !recordPath.isEmpty())
+    {
+        m_wallet->recordCallbacks(recordPath);
+    }
+
+    if (const auto replayPath = m_settings.getCallbackReplayPath(); !replayPath.isEmpty())
+    {
+        // the trace is the only source of wallet events, neither the node nor the wallet client are started
+        m_callbackReplay = std::make_unique<CallbackReplay>(*m_wallet, replayPath, m_settings.getCallbackReplaySpeed(), m_settings.quitAfterCallbackReplay());
+    }
+    else if (const auto syntheticLoad = m_settings.getSyntheticLoad(); !syntheticLoad.isEmpty())
+    {
+        // the same for the generated load, so the database and the node cannot mix into the measurements
+        m_syntheticLoad = std::make_unique<SyntheticLoad>(*m_wallet, SyntheticLoad::Config::parse(syntheticLoad));
+    }
+    else
+#endif
     if (m_settings.getRunLocalNode())
     {
         startNode();
@@ -507,6 +546,16 @@ MessageManager& AppModel::getMessages()
     return m_messages;
 }
 
+EventMonitor& AppModel::getEventMonitor()
+{
+    return m_eventMonitor;
+}
+
+StallWatchdog* AppModel::getStallWatchdog() const
+{
+    return m_stallWatchdog.get();
+}
+
 NodeModel& AppModel::getNode()
 {
     return m_nodeModel;
@@ -17,6 +17,12 @@
 #include "swap_coin_client_model.h"
 #include "settings.h"
 #include "messages.h"
+#include "event_monitor.h"
+#include "stall_watchdog.h"
+#if defined(BEAM_UI_PROFILING)
+#include "synthetic_load.h"
+#include "callback_trace.h"
+#endif
 #include "node_model.h"
 #include "helpers.h"
 #include "wallet/core/secstring.h"
@@ -64,6 +70,8 @@ public:
     WalletModel::Ptr getWallet() const;
     WalletSettings& getSettings() const;
     MessageManager& getMessages();
+    EventMonitor& getEventMonitor();
+    StallWatchdog* getStallWatchdog() const;
     NodeModel& getNode();
     SwapCoinClientModel::Ptr getSwapCoinClient(beam::wallet::AtomicSwapCoin swapCoin) const;
 
@@ -92,11 +100,19 @@ private:
     void registerSwapFactory(beam::wallet::AtomicSwapCoin swapCoin, beam::wallet::AtomicSwapTransaction::Creator& swapTxCreator);
 
 private:
+    // models report to the monitor, so it is destroyed last
+    EventMonitor m_eventMonitor;
+    std::unique_ptr<StallWatchdog> m_stallWatchdog;
+
     // SwapCoinClientModels must be destroyed after WalletModel
     std::map<beam::wallet::AtomicSwapCoin, SwapCoinClientModel::Ptr> m_swapClients;
     std::map<beam::wallet::AtomicSwapCoin, beam::bitcoin::IBridgeHolder::Ptr> m_swapBridgeHolders;
 
     WalletModel::Ptr m_wallet;
+#if defined(BEAM_UI_PROFILING)
+    std::unique_ptr<SyntheticLoad> m_syntheticLoad;  // feeds m_wallet, so it is destroyed first
+    std::unique_ptr<CallbackReplay> m_callbackReplay; // the same
+#endif
     NodeModel m_nodeModel;
     WalletSettings& m_settings;
     MessageManager m_messages;
@@ -0,0 +1,728 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "callback_trace.h"
+#include "wallet_model.h"
+#include "app_model.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+#include <cstring>
+#include <type_traits>
+
+#include "utility/logger.h"
+
+using namespace beam;
+using namespace beam::wallet;
+using callback_trace::Kind;
+
+namespace
+{
+    const quint32 kTraceMagic = 0x42435452;     // "BCTR"
+    const quint32 kTraceVersion = 2;
+    const auto kStreamVersion = QDataStream::Qt_5_12;
+    const char* kReportFileName = "ui_replay.json";
+
+    void writeBytes(QDataStream& s, const ByteBuffer& value)
+    {
+        s << QByteArray(reinterpret_cast<const char*>(value.data()), static_cast<int>(value.size()));
+    }
+
+    ByteBuffer readBytes(QDataStream& s)
+    {
+        QByteArray value;
+        s >> value;
+        return ByteBuffer(value.begin(), value.end());
+    }
+
+    // ids, hashes and the types beam serializes itself
+    template <typename T>
+    void writeBlob(QDataStream& s, const T& value)
+    {
+        writeBytes(s, toByteBuffer(value));
+    }
+
+    template <typename T>
+    T readBlob(QDataStream& s)
+    {
+        T value;
+        if (!fromByteBuffer(readBytes(s), value))
+        {
+            s.setStatus(QDataStream::ReadCorruptData);
+        }
+        return value;
+    }
+
+    template <typename T>
+    void writeInt(QDataStream& s, T value)
+    {
+        s << static_cast<quint64>(value);
+    }
+
+    template <typename T>
+    T readInt(QDataStream& s)
+    {
+        quint64 value = 0;
+        s >> value;
+        return static_cast<T>(value);
+    }
+
+    template <typename E>
+    void writeEnum(QDataStream& s, E value)
+    {
+        s << static_cast<qint32>(value);
+    }
+
+    template <typename E>
+    E readEnum(QDataStream& s)
+    {
+        qint32 value = 0;
+        s >> value;
+        return static_cast<E>(value);
+    }
+
+    bool readBool(QDataStream& s)
+    {
+        bool value = false;
+        s >> value;
+        return value;
+    }
+
+    template <typename T, typename Write>
+    void writeItems(QDataStream& s, const std::vector<T>& items, Write&& write)
+    {
+        s << static_cast<quint32>(items.size());
+        for (const auto& item : items)
+        {
+            write(s, item);
+        }
+    }
+
+    template <typename T, typename Read>
+    std::vector<T> readItems(QDataStream& s, Read&& read)
+    {
+        quint32 count = 0;
+        s >> count;
+        std::vector<T> items;
+        items.reserve(std::min<quint32>(count, 1 << 16));   // the count is not trusted before the items are read
+        for (quint32 i = 0; i < count && s.status() == QDataStream::Ok; ++i)
+        {
+            items.push_back(read(s));
+        }
+        return items;
+    }
+
+    void writeParameters(QDataStream& s, const TxParameters& params)
+    {
+        const auto packed = params.Pack();
+        s << static_cast<quint32>(packed.size());
+        for (const auto& p : packed)
+        {
+            writeEnum(s, p.first);
+            writeBytes(s, p.second);
+        }
+    }
+
+    void readParameters(QDataStream& s, TxParameters& params)
+    {
+        quint32 count = 0;
+        s >> count;
+        for (quint32 i = 0; i < count && s.status() == QDataStream::Ok; ++i)
+        {
+            const auto id = readEnum<TxParameterID>(s);
+            const auto value = readBytes(s);
+            params.SetParameter(id, value);
+        }
+    }
+
+    // plain structs beam does not serialize, kept whole so that no member is lost;
+    // a trace of a build where the struct has another layout is rejected as corrupt
+    template <typename T>
+    void writeRaw(QDataStream& s, const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "only plain structs are written as is");
+        s << QByteArray(reinterpret_cast<const char*>(&value), static_cast<int>(sizeof(T)));
+    }
+
+    template <typename T>
+    void readRaw(QDataStream& s, T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "only plain structs are read as is");
+        QByteArray bytes;
+        s >> bytes;
+        if (bytes.size() != static_cast<int>(sizeof(T)))
+        {
+            s.setStatus(QDataStream::ReadCorruptData);
+            return;
+        }
+        std::memcpy(&value, bytes.constData(), sizeof(T));
+    }
+
+    void writeStatus(QDataStream& s, const WalletStatus& status)
+    {
+        writeBlob(s, status.stateID);
+        writeRaw(s, status.update);
+        s << static_cast<quint32>(status.all.size());
+        for (const auto& p : status.all)
+        {
+            writeInt(s, p.first);
+            writeRaw(s, p.second);
+        }
+    }
+
+    WalletStatus readStatus(QDataStream& s)
+    {
+        WalletStatus status;
+        status.stateID = readBlob<decltype(status.stateID)>(s);
+        readRaw(s, status.update);
+        quint32 count = 0;
+        s >> count;
+        for (quint32 i = 0; i < count && s.status() == QDataStream::Ok; ++i)
+        {
+            const auto assetId = readInt<Asset::ID>(s);
+            readRaw(s, status.all[assetId]);
+        }
+        return status;
+    }
+
+    void writeTx(QDataStream& s, const TxDescription& tx)
+    {
+        writeBlob(s, tx.m_txId);
+        writeEnum(s, tx.m_txType);
+        writeInt(s, tx.m_assetId);
+        writeInt(s, tx.m_amount);
+        writeInt(s, tx.m_fee);
+        writeEnum(s, tx.m_status);
+        writeEnum(s, tx.m_failureReason);
+        s << tx.m_sender << tx.m_selfTx;
+        writeInt(s, tx.m_createTime);
+        writeInt(s, tx.m_modifyTime);
+        writeBlob(s, tx.m_peerId);
+        writeBlob(s, tx.m_myId);
+        writeBytes(s, tx.m_message);
+        writeBlob(s, tx.m_kernelID);
+        writeParameters(s, tx);
+    }
+
+    TxDescription readTx(QDataStream& s)
+    {
+        TxDescription tx;
+        tx.m_txId = readBlob<TxID>(s);
+        tx.m_txType = readEnum<TxType>(s);
+        tx.m_assetId = readInt<Asset::ID>(s);
+        tx.m_amount = readInt<Amount>(s);
+        tx.m_fee = readInt<Amount>(s);
+        tx.m_status = readEnum<TxStatus>(s);
+        tx.m_failureReason = readEnum<TxFailureReason>(s);
+        tx.m_sender = readBool(s);
+        tx.m_selfTx = readBool(s);
+        tx.m_createTime = readInt<Timestamp>(s);
+        tx.m_modifyTime = readInt<Timestamp>(s);
+        tx.m_peerId = readBlob<WalletID>(s);
+        tx.m_myId = readBlob<WalletID>(s);
+        tx.m_message = readBytes(s);
+        tx.m_kernelID = readBlob<decltype(tx.m_kernelID)>(s);
+        readParameters(s, tx);
+        return tx;
+    }
+
+    void writeCoin(QDataStream& s, const Coin& coin)
+    {
+        writeBlob(s, coin.m_ID);
+        writeEnum(s, coin.m_status);
+        writeInt(s, coin.m_maturity);
+        writeInt(s, coin.m_confirmHeight);
+    }
+
+    Coin readCoin(QDataStream& s)
+    {
+        Coin coin;
+        coin.m_ID = readBlob<decltype(coin.m_ID)>(s);
+        coin.m_status = readEnum<Coin::Status>(s);
+        coin.m_maturity = readInt<Height>(s);
+        coin.m_confirmHeight = readInt<Height>(s);
+        return coin;
+    }
+
+#ifdef BEAM_LELANTUS_SUPPORT
+    void writeShieldedCoin(QDataStream& s, const ShieldedCoin& coin)
+    {
+        writeBlob(s, coin.m_CoinID);
+        writeInt(s, coin.m_TxoID);
+        writeInt(s, coin.m_confirmHeight);
+        writeInt(s, coin.m_spentHeight);
+        writeEnum(s, coin.m_Status);
+        s << static_cast<bool>(coin.m_createTxId);
+        if (coin.m_createTxId)
+        {
+            writeBlob(s, *coin.m_createTxId);
+        }
+        s << static_cast<bool>(coin.m_spentTxId);
+        if (coin.m_spentTxId)
+        {
+            writeBlob(s, *coin.m_spentTxId);
+        }
+    }
+
+    ShieldedCoin readShieldedCoin(QDataStream& s)
+    {
+        ShieldedCoin coin;
+        coin.m_CoinID = readBlob<decltype(coin.m_CoinID)>(s);
+        coin.m_TxoID = readInt<TxoID>(s);
+        coin.m_confirmHeight = readInt<Height>(s);
+        coin.m_spentHeight = readInt<Height>(s);
+        coin.m_Status = readEnum<ShieldedCoin::Status>(s);
+        if (readBool(s))
+        {
+            coin.m_createTxId = readBlob<TxID>(s);
+        }
+        if (readBool(s))
+        {
+            coin.m_spentTxId = readBlob<TxID>(s);
+        }
+        return coin;
+    }
+#endif  // BEAM_LELANTUS_SUPPORT
+
+    void writeAsset(QDataStream& s, const WalletAsset& asset)
+    {
+        writeInt(s, asset.m_ID);
+        writeBlob(s, asset.m_Value);
+        writeInt(s, asset.m_LockHeight);
+        writeBytes(s, asset.m_Metadata.m_Value);
+        writeInt(s, asset.m_RefreshHeight);
+    }
+
+    WalletAsset readAsset(QDataStream& s)
+    {
+        WalletAsset asset;
+        asset.m_ID = readInt<Asset::ID>(s);
+        asset.m_Value = readBlob<decltype(asset.m_Value)>(s);
+        asset.m_LockHeight = readInt<Height>(s);
+        asset.m_Metadata.m_Value = readBytes(s);
+        asset.m_Metadata.UpdateHash();
+        asset.m_RefreshHeight = readInt<Height>(s);
+        return asset;
+    }
+
+#ifdef BEAM_ATOMIC_SWAP_SUPPORT
+    void writeOffer(QDataStream& s, const SwapOffer& offer)
+    {
+        writeBlob(s, offer.m_txId);
+        writeEnum(s, offer.m_status);
+        writeBlob(s, offer.m_publisherId);
+        writeEnum(s, offer.m_coin);
+        s << offer.m_isOwn;
+        writeParameters(s, offer);
+    }
+
+    SwapOffer readOffer(QDataStream& s)
+    {
+        SwapOffer offer(readBlob<TxID>(s));
+        offer.m_status = readEnum<SwapOfferStatus>(s);
+        offer.m_publisherId = readBlob<WalletID>(s);
+        offer.m_coin = readEnum<AtomicSwapCoin>(s);
+        offer.m_isOwn = readBool(s);
+        readParameters(s, offer);
+        return offer;
+    }
+#endif  // BEAM_ATOMIC_SWAP_SUPPORT
+
+    void writeNotification(QDataStream& s, const Notification& notification)
+    {
+        writeBlob(s, notification.m_ID);
+        writeEnum(s, notification.m_type);
+        writeEnum(s, notification.m_state);
+        writeInt(s, notification.m_createTime);
+        writeBytes(s, notification.m_content);
+    }
+
+    Notification readNotification(QDataStream& s)
+    {
+        Notification notification;
+        notification.m_ID = readBlob<decltype(notification.m_ID)>(s);
+        notification.m_type = readEnum<Notification::Type>(s);
+        notification.m_state = readEnum<Notification::State>(s);
+        notification.m_createTime = readInt<Timestamp>(s);
+        notification.m_content = readBytes(s);
+        return notification;
+    }
+}
+
+CallbackRecorder::CallbackRecorder(const QString& path)
+    : m_file(path)
+    , m_started(std::chrono::steady_clock::now())
+{
+    if (!m_file.open(QIODevice::WriteOnly))
+    {
+        LOG_ERROR() << "Failed to open " << path.toStdString() << " for the callback trace";
+        return;
+    }
+
+    m_stream.setDevice(&m_file);
+    m_stream.setVersion(kStreamVersion);
+    m_stream << kTraceMagic << kTraceVersion;
+    LOG_INFO() << "Recording wallet callbacks to " << path.toStdString();
+}
+
+bool CallbackRecorder::isOpen() const
+{
+    return m_file.isOpen();
+}
+
+template <typename Writer>
+void CallbackRecorder::write(Kind kind, Writer&& writer)
+{
+    if (!isOpen())
+    {
+        return;
+    }
+
+    // records are framed, so a reader can skip the kinds it does not know
+    QByteArray payload;
+    {
+        QDataStream stream(&payload, QIODevice::WriteOnly);
+        stream.setVersion(kStreamVersion);
+        writer(stream);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto offset = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_started).count();
+    m_stream << static_cast<qint64>(offset) << static_cast<quint8>(kind) << payload;
+}
+
+void CallbackRecorder::onStatus(const WalletStatus& status)
+{
+    write(Kind::Status, [&] (QDataStream& s) { writeStatus(s, status); });
+}
+
+void CallbackRecorder::onTxStatus(ChangeAction action, const std::vector<TxDescription>& items)
+{
+    write(Kind::TxStatus, [&] (QDataStream& s)
+    {
+        writeEnum(s, action);
+        writeItems(s, items, writeTx);
+    });
+}
+
+void CallbackRecorder::onAllUtxoChanged(ChangeAction action, const std::vector<Coin>& utxos)
+{
+    write(Kind::AllUtxoChanged, [&] (QDataStream& s)
+    {
+        writeEnum(s, action);
+        writeItems(s, utxos, writeCoin);
+    });
+}
+
+#ifdef BEAM_LELANTUS_SUPPORT
+void CallbackRecorder::onShieldedCoinChanged(ChangeAction action, const std::vector<ShieldedCoin>& items)
+{
+    write(Kind::ShieldedCoinChanged, [&] (QDataStream& s)
+    {
+        writeEnum(s, action);
+        writeItems(s, items, writeShieldedCoin);
+    });
+}
+#endif  // BEAM_LELANTUS_SUPPORT
+
+void CallbackRecorder::onAddressesChanged(ChangeAction action, const std::vector<WalletAddress>& items)
+{
+    write(Kind::AddressesChanged, [&] (QDataStream& s)
+    {
+        writeEnum(s, action);
+        writeBlob(s, items);
+    });
+}
+
+void CallbackRecorder::onAddresses(bool own, const std::vector<WalletAddress>& addrs)
+{
+    write(Kind::Addresses, [&] (QDataStream& s)
+    {
+        s << own;
+        writeBlob(s, addrs);
+    });
+}
+
+#ifdef BEAM_ATOMIC_SWAP_SUPPORT
+void CallbackRecorder::onSwapOffersChanged(ChangeAction action, const std::vector<SwapOffer>& offers)
+{
+    write(Kind::SwapOffersChanged, [&] (QDataStream& s)
+    {
+        writeEnum(s, action);
+        writeItems(s, offers, writeOffer);
+    });
+}
+#endif  // BEAM_ATOMIC_SWAP_SUPPORT
+
+void CallbackRecorder::onExchangeRates(const std::vector<ExchangeRate>& rates)
+{
+    write(Kind::ExchangeRates, [&] (QDataStream& s) { writeBlob(s, rates); });
+}
+
+void CallbackRecorder::onNotificationsChanged(ChangeAction action, const std::vector<Notification>& notifications)
+{
+    write(Kind::NotificationsChanged, [&] (QDataStream& s)
+    {
+        writeEnum(s, action);
+        writeItems(s, notifications, writeNotification);
+    });
+}
+
+void CallbackRecorder::onNodeConnectionChanged(bool isNodeConnected)
+{
+    write(Kind::NodeConnectionChanged, [&] (QDataStream& s) { s << isNodeConnected; });
+}
+
+void CallbackRecorder::onSyncProgressUpdated(int done, int total)
+{
+    write(Kind::SyncProgressUpdated, [&] (QDataStream& s) { s << static_cast<qint32>(done) << static_cast<qint32>(total); });
+}
+
+void CallbackRecorder::onAssetInfo(Asset::ID assetId, const WalletAsset& info)
+{
+    write(Kind::AssetInfo, [&] (QDataStream& s)
+    {
+        writeInt(s, assetId);
+        writeAsset(s, info);
+    });
+}
+
+CallbackReplay::CallbackReplay(WalletModel& model, const QString& path, double speed, bool quit)
+    : m_model(model)
+    , m_path(path)
+    , m_speed(std::max(speed, 0.0))
+    , m_quit(quit)
+{
+    LOG_INFO() << "Replaying wallet callbacks from " << m_path.toStdString() << ", speed " << m_speed;
+    m_thread = std::thread([this] () { run(); });
+}
+
+CallbackReplay::~CallbackReplay()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeUp.notify_one();
+    m_thread.join();
+}
+
+void CallbackReplay::run()
+{
+    QFile file(m_path);
+    QDataStream stream(&file);
+    stream.setVersion(kStreamVersion);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    if (file.open(QIODevice::ReadOnly))
+    {
+        stream >> magic >> version;
+    }
+    if (magic != kTraceMagic || version != kTraceVersion)
+    {
+        LOG_ERROR() << "Cannot replay " << m_path.toStdString() << ": not a callback trace or an unsupported version";
+        QMetaObject::invokeMethod(this, [this] () { report(0, 0, 0, false); }, Qt::QueuedConnection);
+        return;
+    }
+
+    const auto started = Clock::now();
+    uint64_t records = 0;
+    qint64 offset = 0;
+    bool complete = true;
+    while (!stream.atEnd())
+    {
+        quint8 kind = 0;
+        QByteArray payload;
+        stream >> offset >> kind >> payload;
+        if (stream.status() != QDataStream::Ok)
+        {
+            complete = false;
+            break;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            const auto due = m_speed > 0 ? started + std::chrono::microseconds(static_cast<int64_t>(offset / m_speed)) : Clock::now();
+            if (m_wakeUp.wait_until(lock, due, [this] () { return m_stop; }))
+            {
+                return;
+            }
+        }
+
+        QDataStream payloadStream(payload);
+        payloadStream.setVersion(kStreamVersion);
+        if (!dispatch(static_cast<Kind>(kind), payloadStream))
+        {
+            complete = false;
+            break;
+        }
+        ++records;
+    }
+
+    if (!complete)
+    {
+        LOG_WARNING() << "Callback trace " << m_path.toStdString() << " is damaged after " << records << " records";
+    }
+
+    const auto replayMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - started).count();
+    QMetaObject::invokeMethod(this, [this, records, offset, replayMs, complete] ()
+    {
+        report(records, offset / 1000, replayMs, complete);
+    }, Qt::QueuedConnection);
+}
+
+bool CallbackReplay::dispatch(Kind kind, QDataStream& s)
+{
+    const auto isOk = [&s] () { return s.status() == QDataStream::Ok; };
+
+    switch (kind)
+    {
+    case Kind::Status:
+    {
+        const auto status = readStatus(s);
+        if (!isOk()) return false;
+        m_model.onStatus(status);
+        break;
+    }
+    case Kind::TxStatus:
+    {
+        const auto action = readEnum<ChangeAction>(s);
+        const auto items = readItems<TxDescription>(s, readTx);
+        if (!isOk()) return false;
+        m_model.onTxStatus(action, items);
+        break;
+    }
+    case Kind::AllUtxoChanged:
+    {
+        const auto action = readEnum<ChangeAction>(s);
+        const auto utxos = readItems<Coin>(s, readCoin);
+        if (!isOk()) return false;
+        m_model.onAllUtxoChanged(action, utxos);
+        break;
+    }
+    case Kind::AddressesChanged:
+    {
+        const auto action = readEnum<ChangeAction>(s);
+        const auto items = readBlob<std::vector<WalletAddress>>(s);
+        if (!isOk()) return false;
+        m_model.onAddressesChanged(action, items);
+        break;
+    }
+    case Kind::Addresses:
+    {
+        const auto own = readBool(s);
+        const auto addrs = readBlob<std::vector<WalletAddress>>(s);
+        if (!isOk()) return false;
+        m_model.onAddresses(own, addrs);
+        break;
+    }
+    case Kind::SwapOffersChanged:
+    {
+#ifdef BEAM_ATOMIC_SWAP_SUPPORT
+        const auto action = readEnum<ChangeAction>(s);
+        const auto offers = readItems<SwapOffer>(s, readOffer);
+        if (!isOk()) return false;
+        m_model.onSwapOffersChanged(action, offers);
+#endif  // BEAM_ATOMIC_SWAP_SUPPORT
+        break;
+    }
+    case Kind::ExchangeRates:
+    {
+        const auto rates = readBlob<std::vector<ExchangeRate>>(s);
+        if (!isOk()) return false;
+        m_model.onExchangeRates(rates);
+        break;
+    }
+    case Kind::NotificationsChanged:
+    {
+        const auto action = readEnum<ChangeAction>(s);
+        const auto notifications = readItems<Notification>(s, readNotification);
+        if (!isOk()) return false;
+        m_model.onNotificationsChanged(action, notifications);
+        break;
+    }
+    case Kind::NodeConnectionChanged:
+    {
+        const auto connected = readBool(s);
+        if (!isOk()) return false;
+        m_model.onNodeConnectionChanged(connected);
+        break;
+    }
+    case Kind::SyncProgressUpdated:
+    {
+        qint32 done = 0;
+        qint32 total = 0;
+        s >> done >> total;
+        if (!isOk()) return false;
+        m_model.onSyncProgressUpdated(done, total);
+        break;
+    }
+    case Kind::ShieldedCoinChanged:
+    {
+#ifdef BEAM_LELANTUS_SUPPORT
+        const auto action = readEnum<ChangeAction>(s);
+        const auto items = readItems<ShieldedCoin>(s, readShieldedCoin);
+        if (!isOk()) return false;
+        m_model.onShieldedCoinChanged(action, items);
+#endif  // BEAM_LELANTUS_SUPPORT
+        break;
+    }
+    case Kind::AssetInfo:
+    {
+        const auto assetId = readInt<Asset::ID>(s);
+        const auto info = readAsset(s);
+        if (!isOk()) return false;
+        m_model.onAssetInfo(assetId, info);
+        break;
+    }
+    default:
+        // written by a newer build
+        break;
+    }
+    return true;
+}
+
+void CallbackReplay::report(uint64_t records, int64_t traceMs, int64_t replayMs, bool complete)
+{
+    QJsonObject root;
+    root.insert("trace", m_path);
+    root.insert("speed", m_speed);
+    root.insert("records", static_cast<qint64>(records));
+    root.insert("complete", complete);
+    root.insert("trace_ms", static_cast<qint64>(traceMs));
+    root.insert("replay_ms", static_cast<qint64>(replayMs));
+    root.insert("events", AppModel::getInstance().getEventMonitor().toJson().object());
+
+    const auto path = QDir(QString::fromStdString(AppModel::getInstance().getSettings().getAppDataPath()))
+        .filePath(QString(WalletSettings::LogsFolder) + "/" + kReportFileName);
+    QSaveFile file(path);
+    if (file.open(QIODevice::WriteOnly) && file.write(QJsonDocument(root).toJson()) >= 0 && file.commit())
+    {
+        LOG_INFO() << "Replayed " << records << " callbacks in " << replayMs << " ms, report: " << path.toStdString();
+    }
+    else
+    {
+        LOG_WARNING() << "Replayed " << records << " callbacks, failed to write " << path.toStdString();
+    }
+
+    if (m_quit)
+    {
+        QCoreApplication::quit();
+    }
+}
@@ -0,0 +1,119 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QObject>
+#include <QDataStream>
+#include <QFile>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "wallet/client/wallet_client.h"
+
+class WalletModel;
+
+// Binary traces of the WalletClient callbacks which carry the wallet state to the UI.
+// Every record keeps the time since the recording has started, the callback and its arguments,
+// so a trace captured on a busy wallet can be played back into the UI for comparable profiling runs.
+// Request/response callbacks (address checks, exports, key keeper) are not recorded,
+// nothing in a replay would be waiting for them; asset info is, the views show it wherever an asset is mentioned
+namespace callback_trace
+{
+    enum class Kind : quint8
+    {
+        Status,
+        TxStatus,
+        AllUtxoChanged,
+        AddressesChanged,
+        Addresses,
+        SwapOffersChanged,
+        ExchangeRates,
+        NotificationsChanged,
+        NodeConnectionChanged,
+        SyncProgressUpdated,
+        ShieldedCoinChanged,
+        AssetInfo
+    };
+}
+
+// Writes the trace, called on the reactor thread.
+// Enabled by debug/record_callbacks in settings.ini, set to the trace file path
+class CallbackRecorder
+{
+public:
+    explicit CallbackRecorder(const QString& path);
+
+    bool isOpen() const;
+
+    void onStatus(const beam::wallet::WalletStatus& status);
+    void onTxStatus(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& items);
+    void onAllUtxoChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::Coin>& utxos);
+#ifdef BEAM_LELANTUS_SUPPORT
+    void onShieldedCoinChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::ShieldedCoin>& items);
+#endif  // BEAM_LELANTUS_SUPPORT
+    void onAddressesChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::WalletAddress>& items);
+    void onAddresses(bool own, const std::vector<beam::wallet::WalletAddress>& addrs);
+#ifdef BEAM_ATOMIC_SWAP_SUPPORT
+    void onSwapOffersChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::SwapOffer>& offers);
+#endif  // BEAM_ATOMIC_SWAP_SUPPORT
+    void onExchangeRates(const std::vector<beam::wallet::ExchangeRate>& rates);
+    void onNotificationsChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::Notification>& notifications);
+    void onNodeConnectionChanged(bool isNodeConnected);
+    void onSyncProgressUpdated(int done, int total);
+    void onAssetInfo(beam::Asset::ID assetId, const beam::wallet::WalletAsset& info);
+
+private:
+    template <typename Writer>
+    void write(callback_trace::Kind kind, Writer&& writer);
+
+    std::mutex m_mutex;
+    QFile m_file;
+    QDataStream m_stream;
+    std::chrono::steady_clock::time_point m_started;
+};
+
+// Plays a trace back into WalletModel from its own thread, the way the reactor would.
+// Enabled by debug/replay_callbacks in settings.ini, set to the trace file path; the wallet
+// client is not started then, so neither the node nor the wallet database feed the UI.
+// debug/replay_speed scales the recorded pauses: 1 keeps them, 2 halves them, 0 drops them.
+// Writes logs/ui_replay.json with the EventMonitor statistics when done and quits
+// the application if debug/replay_quit is set
+class CallbackReplay : public QObject
+{
+    Q_OBJECT
+public:
+    CallbackReplay(WalletModel& model, const QString& path, double speed, bool quit);
+    ~CallbackReplay() override;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void run();
+    bool dispatch(callback_trace::Kind kind, QDataStream& stream);
+    void report(uint64_t records, int64_t traceMs, int64_t replayMs, bool complete);
+
+    WalletModel& m_model;
+    const QString m_path;
+    const double m_speed;
+    const bool m_quit;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeUp;
+    bool m_stop = false;
+    std::thread m_thread;
+};
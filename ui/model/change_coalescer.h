@@ -0,0 +1,220 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "wallet/client/wallet_client.h"
+
+// Merges change notifications of one kind until they are taken.
+// Items are matched by key: Added+Updated stays Added, Updated+Removed becomes Removed,
+// Added+Removed disappears and a Reset drops everything before it.
+// take() returns either a single Reset or Removed, Added and Updated batches in this order
+template <typename Item, typename Key>
+class ChangeCoalescer
+{
+public:
+    using KeyFunc = std::function<Key(const Item&)>;
+    using Batch = std::pair<beam::wallet::ChangeAction, std::vector<Item>>;
+
+    explicit ChangeCoalescer(KeyFunc key)
+        : m_key(std::move(key))
+    {
+    }
+
+    bool empty() const
+    {
+        return !m_reset && m_entries.empty();
+    }
+
+    void add(beam::wallet::ChangeAction action, const std::vector<Item>& items)
+    {
+        using beam::wallet::ChangeAction;
+
+        if (action == ChangeAction::Reset)
+        {
+            m_entries.clear();
+            m_reset = true;
+            for (const auto& item : items)
+            {
+                set(m_key(item), State::Added, item);
+            }
+            return;
+        }
+
+        for (const auto& item : items)
+        {
+            const auto key = m_key(item);
+            auto it = m_entries.find(key);
+
+            if (m_reset)
+            {
+                // everything is delivered as a part of the Reset, only presence matters
+                if (action == ChangeAction::Removed)
+                {
+                    if (it != m_entries.end())
+                    {
+                        m_entries.erase(it);
+                    }
+                }
+                else
+                {
+                    set(key, State::Added, item);
+                }
+                continue;
+            }
+
+            if (it == m_entries.end())
+            {
+                set(key, action == ChangeAction::Added ? State::Added :
+                         action == ChangeAction::Removed ? State::Removed : State::Updated, item);
+                continue;
+            }
+
+            auto& entry = it->second;
+            if (action == ChangeAction::Removed)
+            {
+                switch (entry.state)
+                {
+                case State::Added:
+                    m_entries.erase(it);
+                    break;
+                case State::Replaced:
+                    entry.state = State::Removed;
+                    entry.item = *entry.removed;
+                    entry.removed.reset();
+                    break;
+                default:
+                    entry.state = State::Removed;
+                    entry.item = item;
+                    break;
+                }
+                continue;
+            }
+
+            if (entry.state == State::Removed)
+            {
+                // subscribers still have the removed item, it is replaced by the new one
+                entry.removed = entry.item;
+                entry.state = State::Replaced;
+            }
+            entry.item = item;
+        }
+    }
+
+    std::vector<Batch> take()
+    {
+        using beam::wallet::ChangeAction;
+
+        // items are moved into the batches, the entries are dropped right after
+        std::vector<Entry*> entries;
+        entries.reserve(m_entries.size());
+        for (auto& p : m_entries)
+        {
+            entries.push_back(&p.second);
+        }
+        std::sort(entries.begin(), entries.end(), [](const Entry* l, const Entry* r) { return l->seq < r->seq; });
+
+        std::vector<Batch> batches;
+        if (m_reset)
+        {
+            Batch reset{ ChangeAction::Reset, {} };
+            reset.second.reserve(entries.size());
+            for (auto* entry : entries)
+            {
+                reset.second.push_back(std::move(entry->item));
+            }
+            batches.push_back(std::move(reset));
+        }
+        else
+        {
+            Batch removed{ ChangeAction::Removed, {} };
+            Batch added{ ChangeAction::Added, {} };
+            Batch updated{ ChangeAction::Updated, {} };
+            for (auto* entry : entries)
+            {
+                switch (entry->state)
+                {
+                case State::Added:
+                    added.second.push_back(std::move(entry->item));
+                    break;
+                case State::Updated:
+                    updated.second.push_back(std::move(entry->item));
+                    break;
+                case State::Removed:
+                    removed.second.push_back(std::move(entry->item));
+                    break;
+                case State::Replaced:
+                    removed.second.push_back(std::move(*entry->removed));
+                    added.second.push_back(std::move(entry->item));
+                    break;
+                }
+            }
+            for (auto* batch : { &removed, &added, &updated })
+            {
+                if (!batch->second.empty())
+                {
+                    batches.push_back(std::move(*batch));
+                }
+            }
+        }
+
+        m_entries.clear();
+        m_reset = false;
+        return batches;
+    }
+
+private:
+    enum class State
+    {
+        Added,
+        Updated,
+        Removed,
+        Replaced // removed and added again
+    };
+
+    struct Entry
+    {
+        uint64_t seq;
+        State state;
+        Item item;
+        boost::optional<Item> removed;
+    };
+
+    void set(const Key& key, State state, const Item& item)
+    {
+        auto it = m_entries.find(key);
+        if (it == m_entries.end())
+        {
+            m_entries.emplace(key, Entry{ m_nextSeq++, state, item, boost::none });
+        }
+        else
+        {
+            it->second.state = state;
+            it->second.item = item;
+        }
+    }
+
+    KeyFunc m_key;
+    bool m_reset = false;
+    uint64_t m_nextSeq = 0;
+    std::map<Key, Entry> m_entries;
+};
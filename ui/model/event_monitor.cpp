@@ -0,0 +1,196 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "event_monitor.h"
+
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cassert>
+
+#include "utility/logger.h"
+
+namespace
+{
+    const char* kDumpFileName = "ui_events.json";
+
+    int64_t toMicroseconds(EventMonitor::Clock::duration d)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+    }
+
+    int64_t toMilliseconds(EventMonitor::Clock::duration d)
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(d).count();
+    }
+
+    const char* kindName(EventMonitor::Kind kind)
+    {
+        return kind == EventMonitor::Kind::Latency ? "latency" : "handler";
+    }
+}
+
+EventMonitor* EventMonitor::s_instance = nullptr;
+
+EventMonitor::Scope::Scope(const char* handler)
+    : m_handler(handler)
+    , m_start(Clock::now())
+{
+}
+
+EventMonitor::Scope::~Scope()
+{
+    if (auto monitor = EventMonitor::getInstance())
+    {
+        monitor->addHandlerCost(m_handler, Clock::now() - m_start);
+    }
+}
+
+EventMonitor* EventMonitor::getInstance()
+{
+    return s_instance;
+}
+
+EventMonitor::EventMonitor()
+    : m_started(Clock::now())
+{
+    assert(s_instance == nullptr);
+    s_instance = this;
+    connect(&m_dumpTimer, &QTimer::timeout, this, &EventMonitor::dump);
+}
+
+EventMonitor::~EventMonitor()
+{
+    s_instance = nullptr;
+}
+
+void EventMonitor::addLatency(const char* event, Clock::duration latency)
+{
+    add(event, Kind::Latency, latency);
+}
+
+void EventMonitor::addHandlerCost(const char* handler, Clock::duration cost)
+{
+    add(handler, Kind::Handler, cost);
+}
+
+void EventMonitor::add(const char* name, Kind kind, Clock::duration value)
+{
+    auto it = m_series.find(name);
+    if (it == m_series.end())
+    {
+        it = m_series.emplace(name, Series()).first;
+        it->second.kind = kind;
+    }
+
+    auto& series = it->second;
+    const auto micros = toMicroseconds(value);
+    series.samples[series.count % kSamples] = { toMilliseconds(Clock::now() - m_started), micros };
+    series.max = std::max(series.max, micros);
+    ++series.count;
+}
+
+std::vector<EventMonitor::Summary> EventMonitor::getSummaries() const
+{
+    const auto now = toMilliseconds(Clock::now() - m_started);
+
+    std::vector<Summary> summaries;
+    summaries.reserve(m_series.size());
+    std::vector<int64_t> values;
+    for (const auto& p : m_series)
+    {
+        const auto& series = p.second;
+        const size_t size = std::min<uint64_t>(series.count, kSamples);
+
+        values.clear();
+        uint64_t recent = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            values.push_back(series.samples[i].value);
+            if (now - series.samples[i].timeMs <= kRateWindowMs)
+            {
+                ++recent;
+            }
+        }
+
+        // percentiles are taken over the last kSamples values, max is over the whole run
+        auto percentile = [&values](size_t percent) -> int64_t
+        {
+            if (values.empty())
+            {
+                return 0;
+            }
+            auto nth = values.begin() + (values.size() - 1) * percent / 100;
+            std::nth_element(values.begin(), nth, values.end());
+            return *nth;
+        };
+
+        Summary summary;
+        summary.name = p.first;
+        summary.kind = series.kind;
+        summary.count = series.count;
+        summary.rate = recent * 1000.0 / std::min(kRateWindowMs, std::max<int64_t>(now, 1));
+        summary.p50 = percentile(50);
+        summary.p99 = percentile(99);
+        summary.max = series.max;
+        summaries.push_back(std::move(summary));
+    }
+    return summaries;
+}
+
+QJsonDocument EventMonitor::toJson() const
+{
+    QJsonArray events;
+    for (const auto& summary : getSummaries())
+    {
+        QJsonObject event;
+        event.insert("name", QString::fromStdString(summary.name));
+        event.insert("kind", kindName(summary.kind));
+        event.insert("count", static_cast<qint64>(summary.count));
+        event.insert("rate", summary.rate);
+        event.insert("p50_us", static_cast<qint64>(summary.p50));
+        event.insert("p99_us", static_cast<qint64>(summary.p99));
+        event.insert("max_us", static_cast<qint64>(summary.max));
+        events.append(event);
+    }
+
+    QJsonObject root;
+    root.insert("uptime_ms", static_cast<qint64>(toMilliseconds(Clock::now() - m_started)));
+    root.insert("events", events);
+    return QJsonDocument(root);
+}
+
+void EventMonitor::startDump(const QString& folder)
+{
+    m_dumpFile = QDir(folder).filePath(kDumpFileName);
+    m_dumpTimer.start(kDumpIntervalMs);
+}
+
+void EventMonitor::dump() const
+{
+    if (m_dumpFile.isEmpty())
+    {
+        return;
+    }
+
+    // the file is replaced on every dump, it always holds the latest statistics
+    QSaveFile file(m_dumpFile);
+    if (!file.open(QIODevice::WriteOnly) || file.write(toJson().toJson()) < 0 || !file.commit())
+    {
+        LOG_WARNING() << "Failed to write UI event statistics to " << m_dumpFile.toStdString();
+    }
+}
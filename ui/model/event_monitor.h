@@ -0,0 +1,107 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QObject>
+#include <QJsonDocument>
+#include <QTimer>
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+// Collects how long wallet events wait between the reactor thread and the UI thread
+// and how long UI handlers spend on them. Used from the UI thread only.
+// Statistics are shown by the debug panel in settings and dumped into the logs folder
+class EventMonitor : public QObject
+{
+    Q_OBJECT
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Kind
+    {
+        Latency,
+        Handler
+    };
+
+    struct Summary
+    {
+        std::string name;
+        Kind kind;
+        uint64_t count;
+        double rate;    // per second over the last kRateWindow
+        int64_t p50;    // microseconds
+        int64_t p99;
+        int64_t max;
+    };
+
+    // Measures the scope it lives in as a handler cost
+    class Scope
+    {
+    public:
+        explicit Scope(const char* handler);
+        ~Scope();
+    private:
+        const char* m_handler;
+        Clock::time_point m_start;
+    };
+
+    static EventMonitor* getInstance();
+
+    EventMonitor();
+    ~EventMonitor() override;
+
+    void addLatency(const char* event, Clock::duration latency);
+    void addHandlerCost(const char* handler, Clock::duration cost);
+
+    std::vector<Summary> getSummaries() const;
+    QJsonDocument toJson() const;
+
+    void startDump(const QString& folder);
+    void dump() const;
+
+private:
+    static constexpr size_t kSamples = 1024;
+    static constexpr int64_t kRateWindowMs = 10000;
+    static constexpr int kDumpIntervalMs = 60000;
+
+    struct Sample
+    {
+        int64_t timeMs;
+        int64_t value;
+    };
+
+    struct Series
+    {
+        Kind kind;
+        uint64_t count = 0;
+        int64_t max = 0;
+        std::array<Sample, kSamples> samples;
+    };
+
+    void add(const char* name, Kind kind, Clock::duration value);
+
+    // transparent comparator, so a lookup by const char* does not build a string
+    std::map<std::string, Series, std::less<>> m_series;
+    Clock::time_point m_started;
+    QString m_dumpFile;
+    QTimer m_dumpTimer;
+
+    static EventMonitor* s_instance;
+};
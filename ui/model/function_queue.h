@@ -0,0 +1,165 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+// Multi-producer single-consumer queue of callbacks.
+// Producers push without locks, the consumer detaches everything queued so far
+// with one exchange and runs it in the order it was pushed.
+// A callable is moved into its node as is, so a push allocates once and
+// move-only captures are fine
+class FunctionQueue
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    // called before each function with the name it was pushed with and the time it has waited
+    using WaitObserver = std::function<void(const char* name, Clock::duration wait)>;
+
+    struct Stats
+    {
+        uint64_t pushed = 0;
+        uint64_t drains = 0;
+        uint64_t depth = 0;           // pushed, but not run yet
+        uint64_t maxBatch = 0;
+        uint64_t lastDrainMicroseconds = 0;
+        uint64_t totalDrainMicroseconds = 0;
+    };
+
+    FunctionQueue() = default;
+    FunctionQueue(const FunctionQueue&) = delete;
+    FunctionQueue& operator=(const FunctionQueue&) = delete;
+
+    ~FunctionQueue()
+    {
+        release(m_head.exchange(nullptr));
+    }
+
+    // returns true if the queue was empty, the caller has to schedule a drain then
+    template <typename Func>
+    bool push(Func&& func, const char* name = nullptr)
+    {
+        Node* node = new CallableNode<std::decay_t<Func>>(std::forward<Func>(func), name);
+        node->next = m_head.load(std::memory_order_relaxed);
+        while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+        m_pushed.fetch_add(1, std::memory_order_relaxed);
+        m_depth.fetch_add(1, std::memory_order_relaxed);
+        return node->next == nullptr;
+    }
+
+    // must be called from the consumer thread only
+    void drain(const WaitObserver& observer = {})
+    {
+        const auto start = Clock::now();
+
+        // nodes are pushed on top, so the detached chain is reversed to restore the order
+        Node* head = m_head.exchange(nullptr, std::memory_order_acquire);
+        Node* ordered = nullptr;
+        uint64_t count = 0;
+        while (head)
+        {
+            auto next = head->next;
+            head->next = ordered;
+            ordered = head;
+            head = next;
+            ++count;
+        }
+
+        while (ordered)
+        {
+            auto next = ordered->next;
+            if (observer)
+            {
+                observer(ordered->name, Clock::now() - ordered->pushed);
+            }
+            ordered->run();
+            delete ordered;
+            ordered = next;
+            m_depth.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+        ++m_stats.drains;
+        m_stats.maxBatch = std::max(m_stats.maxBatch, count);
+        m_stats.lastDrainMicroseconds = elapsed;
+        m_stats.totalDrainMicroseconds += elapsed;
+    }
+
+    // must be called from the consumer thread only
+    Stats stats() const
+    {
+        auto stats = m_stats;
+        stats.pushed = m_pushed.load(std::memory_order_relaxed);
+        stats.depth = m_depth.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    struct Node
+    {
+        explicit Node(const char* name_)
+            : name(name_)
+            , pushed(Clock::now())
+        {
+        }
+        virtual ~Node() = default;
+        virtual void run() = 0;
+
+        const char* name;
+        Clock::time_point pushed;
+        Node* next = nullptr;
+    };
+
+    template <typename Func>
+    struct CallableNode : Node
+    {
+        template <typename F>
+        CallableNode(F&& func_, const char* name_)
+            : Node(name_)
+            , func(std::forward<F>(func_))
+        {
+        }
+
+        void run() override
+        {
+            func();
+        }
+
+        Func func;
+    };
+
+    static void release(Node* node)
+    {
+        while (node)
+        {
+            auto next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    std::atomic<Node*> m_head{ nullptr };
+    std::atomic<uint64_t> m_pushed{ 0 };
+    std::atomic<uint64_t> m_depth{ 0 };
+    Stats m_stats;
+};
@@ -0,0 +1,75 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "process_memory.h"
+
+#include <QtGlobal>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#if defined(Q_OS_MACOS)
+#include <mach/mach.h>
+#else
+#include <fstream>
+#endif
+#endif
+
+uint64_t getCurrentRss()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? counters.WorkingSetSize : 0;
+#elif defined(Q_OS_MACOS)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+    {
+        return 0;
+    }
+    return info.resident_size;
+#else
+    // size and resident, in pages
+    uint64_t size = 0;
+    uint64_t resident = 0;
+    std::ifstream statm("/proc/self/statm");
+    if (!(statm >> size >> resident))
+    {
+        return 0;
+    }
+    return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+uint64_t getPeakRss()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? counters.PeakWorkingSetSize : 0;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#if defined(Q_OS_MACOS)
+    return usage.ru_maxrss;         // bytes
+#else
+    return usage.ru_maxrss * 1024;  // kilobytes
+#endif
+#endif
+}
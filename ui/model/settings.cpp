@@ -57,6 +57,19 @@ namespace
     const char* kDevAppURL  = "devapp/url";
     const char* kDevAppName = "devapp/name";
 
+    const char* kShowEventStats = "debug/show_event_stats";
+    const char* kStallThreshold = "debug/stall_threshold_ms";
+    const int kDefaultStallThresholdMs = 0;
+#if defined(BEAM_UI_PROFILING)
+    const char* kSyntheticLoad = "debug/synthetic_load";
+    const char* kRecordCallbacks = "debug/record_callbacks";
+    const char* kReplayCallbacks = "debug/replay_callbacks";
+    const char* kReplaySpeed = "debug/replay_speed";
+    const char* kReplayQuit = "debug/replay_quit";
+    const char* kUiScenario = "debug/ui_scenario";
+    const char* kUiScenarioQuit = "debug/ui_scenario_quit";
+#endif
+
     const std::map<QString, QString> kSupportedLangs { 
         { "zh_CN", "Chinese Simplified"},
         { "en_US", "English" },
@@ -101,6 +114,7 @@ const char* WalletSettings::WalletDBFile = "wallet.db";
 const char* WalletSettings::TrezorWalletDBFile = "trezor-wallet.db";
 #endif
 const char* WalletSettings::NodeDBFile = "node.db";
+const char* WalletSettings::AssetsCacheFile = "assets_cache.bin";
 
 WalletSettings::WalletSettings(const QDir& appDataDir)
     : m_data{ appDataDir.filePath(SettingsFile), QSettings::IniFormat }
@@ -121,6 +135,11 @@ string WalletSettings::getWalletStorage() const
     return getWalletFolder() + "/" + WalletDBFile;
 }
 
+string WalletSettings::getAssetsCacheStorage() const
+{
+    return getWalletFolder() + "/" + AssetsCacheFile;
+}
+
 string WalletSettings::getWalletFolder() const
 {
     Lock lock(m_mutex);
@@ -550,6 +569,15 @@ void WalletSettings::reportProblem()
         }
     }
 
+    // stall counters live in memory only, they are written straight into the archive
+    if (auto watchdog = AppModel::getInstance().getStallWatchdog())
+    {
+        QuaZipFile zipStallsFile(&zip);
+        zipStallsFile.open(QIODevice::WriteOnly, QuaZipNewInfo(logsFolder + "ui_stalls.json"));
+        zipStallsFile.write(watchdog->toJson());
+        zipStallsFile.close();
+    }
+
     zip.close();
 
     QString path = QFileDialog::getSaveFileName(nullptr, "Save problem report", 
@@ -585,4 +613,51 @@ QString WalletSettings::getDevBeamAppUrl()
 QString WalletSettings::getDevBeamAppName()
 {
     return m_data.value(kDevAppName).toString();
-}
\ No newline at end of file
+}
+
+bool WalletSettings::showEventStats()
+{
+    return m_data.value(kShowEventStats, false).toBool();
+}
+
+int WalletSettings::getStallThreshold()
+{
+    return m_data.value(kStallThreshold, kDefaultStallThresholdMs).toInt();
+}
+
+#if defined(BEAM_UI_PROFILING)
+QString WalletSettings::getSyntheticLoad()
+{
+    return m_data.value(kSyntheticLoad).toString();
+}
+
+QString WalletSettings::getCallbackRecordPath()
+{
+    return m_data.value(kRecordCallbacks).toString();
+}
+
+QString WalletSettings::getCallbackReplayPath()
+{
+    return m_data.value(kReplayCallbacks).toString();
+}
+
+double WalletSettings::getCallbackReplaySpeed()
+{
+    return m_data.value(kReplaySpeed, 1.0).toDouble();
+}
+
+bool WalletSettings::quitAfterCallbackReplay()
+{
+    return m_data.value(kReplayQuit, false).toBool();
+}
+
+bool WalletSettings::runUiScenario()
+{
+    return m_data.value(kUiScenario, false).toBool();
+}
+
+bool WalletSettings::quitAfterUiScenario()
+{
+    return m_data.value(kUiScenarioQuit, false).toBool();
+}
+#endif
@@ -47,6 +47,7 @@ public:
     std::string getTrezorWalletStorage() const;
 #endif
     std::string getWalletStorage() const;
+    std::string getAssetsCacheStorage() const;
     std::string getWalletFolder() const;
     std::string getAppDataPath() const;
     void reportProblem();
@@ -87,6 +88,21 @@ public:
     // dev BEAM Apps
     QString getDevBeamAppUrl();
     QString getDevBeamAppName();
+    bool showEventStats();
+    // 0 turns the UI stall watchdog off, it is off by default
+    int getStallThreshold();
+#if defined(BEAM_UI_PROFILING)
+    // see SyntheticLoad, empty when off
+    QString getSyntheticLoad();
+    // see CallbackRecorder and CallbackReplay, empty paths when off
+    QString getCallbackRecordPath();
+    QString getCallbackReplayPath();
+    double getCallbackReplaySpeed();
+    bool quitAfterCallbackReplay();
+    // see UiScenario
+    bool runUiScenario();
+    bool quitAfterUiScenario();
+#endif
 
 public:
     static const char* WalletCfg;
@@ -97,6 +113,7 @@ public:
     static const char* TrezorWalletDBFile;
 #endif
     static const char* NodeDBFile;
+    static const char* AssetsCacheFile;
 
     void applyChanges();
 
@@ -0,0 +1,185 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "stall_watchdog.h"
+
+#include <QAbstractEventDispatcher>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QEvent>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMetaEnum>
+#include <QThread>
+
+#include <algorithm>
+#include <chrono>
+
+#include "utility/logger.h"
+
+namespace
+{
+    const size_t kLatestStalls = 20;
+}
+
+StallWatchdog* StallWatchdog::s_instance = nullptr;
+
+StallWatchdog::StallWatchdog(int thresholdMs)
+    : m_thresholdMs(thresholdMs)
+{
+    s_instance = this;
+    if (auto dispatcher = QAbstractEventDispatcher::instance())
+    {
+        connect(dispatcher, &QAbstractEventDispatcher::aboutToBlock, this, &StallWatchdog::onIdle);
+    }
+    m_thread = std::thread([this] () { watch(); });
+}
+
+StallWatchdog::~StallWatchdog()
+{
+    s_instance = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeUp.notify_one();
+    m_thread.join();
+}
+
+void StallWatchdog::enter(int eventType, const char* receiver)
+{
+    if (m_depth++ == m_idleDepth)
+    {
+        mark(eventType, receiver);
+    }
+}
+
+void StallWatchdog::leave()
+{
+    // the outermost timed dispatch is over, or a modal loop it was timed in has returned
+    if (--m_depth <= m_idleDepth)
+    {
+        onIdle();
+    }
+}
+
+void StallWatchdog::mark(int eventType, const char* receiver)
+{
+    const auto now = nowMs();
+    finish(now);
+    m_eventType.store(eventType, std::memory_order_relaxed);
+    m_receiver.store(receiver, std::memory_order_relaxed);
+    m_busySince.store(now, std::memory_order_release);
+}
+
+void StallWatchdog::onIdle()
+{
+    m_idleDepth = m_depth;
+    finish(nowMs());
+    m_busySince.store(0, std::memory_order_release);
+}
+
+void StallWatchdog::finish(int64_t now)
+{
+    const auto since = m_busySince.load(std::memory_order_relaxed);
+    if (since == 0 || now - since < m_thresholdMs)
+    {
+        return;
+    }
+
+    const auto receiver = m_receiver.load(std::memory_order_relaxed);
+    Stall stall{ QDateTime::currentMSecsSinceEpoch() - (now - since), now - since, eventName(m_eventType.load(std::memory_order_relaxed)), receiver ? receiver : "" };
+    LOG_WARNING() << "UI thread stalled for " << stall.durationMs << " ms handling " << stall.event << " for " << stall.receiver;
+
+    ++m_stalls;
+    m_totalMs += stall.durationMs;
+    m_maxMs = std::max(m_maxMs, stall.durationMs);
+    m_latest.push_back(std::move(stall));
+    if (m_latest.size() > kLatestStalls)
+    {
+        m_latest.pop_front();
+    }
+}
+
+void StallWatchdog::watch()
+{
+    // reports a stall once, while it is still going on
+    int64_t reported = 0;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_wakeUp.wait_for(lock, std::chrono::milliseconds(std::max<int64_t>(m_thresholdMs / 2, 1)), [this] () { return m_stop; }))
+    {
+        const auto since = m_busySince.load(std::memory_order_acquire);
+        if (since == 0 || since == reported || nowMs() - since < m_thresholdMs)
+        {
+            continue;
+        }
+
+        reported = since;
+        const auto receiver = m_receiver.load(std::memory_order_relaxed);
+        LOG_WARNING() << "UI thread is blocked for " << nowMs() - since << " ms handling "
+                      << eventName(m_eventType.load(std::memory_order_relaxed)) << " for " << (receiver ? receiver : "");
+    }
+}
+
+QByteArray StallWatchdog::toJson() const
+{
+    QJsonArray latest;
+    for (const auto& stall : m_latest)
+    {
+        QJsonObject item;
+        item.insert("started", QDateTime::fromMSecsSinceEpoch(stall.startedMs).toString(Qt::ISODate));
+        item.insert("duration_ms", static_cast<qint64>(stall.durationMs));
+        item.insert("event", QString::fromStdString(stall.event));
+        item.insert("receiver", QString::fromStdString(stall.receiver));
+        latest.append(item);
+    }
+
+    QJsonObject root;
+    root.insert("threshold_ms", static_cast<qint64>(m_thresholdMs));
+    root.insert("stalls", static_cast<qint64>(m_stalls));
+    root.insert("total_ms", static_cast<qint64>(m_totalMs));
+    root.insert("max_ms", static_cast<qint64>(m_maxMs));
+    root.insert("latest", latest);
+    return QJsonDocument(root).toJson();
+}
+
+int64_t StallWatchdog::nowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::string StallWatchdog::eventName(int eventType)
+{
+    const auto key = QMetaEnum::fromType<QEvent::Type>().valueToKey(eventType);
+    return key ? key : std::to_string(eventType);
+}
+
+bool WatchedApplication::notify(QObject* receiver, QEvent* event)
+{
+    auto watchdog = StallWatchdog::s_instance;
+    if (!watchdog || QThread::currentThread() != watchdog->thread())
+    {
+        return QApplication::notify(receiver, event);
+    }
+
+    watchdog->enter(event->type(), receiver ? receiver->metaObject()->className() : nullptr);
+    const auto result = QApplication::notify(receiver, event);
+    if (StallWatchdog::s_instance == watchdog)
+    {
+        watchdog->leave();
+    }
+    return result;
+}
@@ -0,0 +1,94 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QApplication>
+#include <QObject>
+#include <QByteArray>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Watches the GUI event loop for stalls.
+// WatchedApplication reports each dispatch on the UI thread. Only the outermost one is timed:
+// events sent synchronously from a handler are part of its time, while the loop going idle
+// inside a modal loop starts timing the dispatches of that loop. A dispatch longer than the
+// threshold is logged with its event type and receiver class when it ends, and a watchdog
+// thread logs the ones which are still going on, so a hang leaves a trace too
+class StallWatchdog : public QObject
+{
+    Q_OBJECT
+public:
+    explicit StallWatchdog(int thresholdMs);
+    ~StallWatchdog() override;
+
+    // counters and the latest stalls, for the problem report
+    QByteArray toJson() const;
+
+private:
+    friend class WatchedApplication;
+    struct Stall
+    {
+        int64_t startedMs;  // wall clock, the durations are measured with the steady clock
+        int64_t durationMs;
+        std::string event;
+        std::string receiver;
+    };
+
+    void enter(int eventType, const char* receiver);
+    void leave();
+    void mark(int eventType, const char* receiver);
+    void onIdle();
+    void finish(int64_t now);
+    void watch();
+
+    static int64_t nowMs();
+    static std::string eventName(int eventType);
+
+    static StallWatchdog* s_instance;
+
+    const int64_t m_thresholdMs;
+
+    // written by the UI thread, read by the watchdog thread
+    std::atomic<int64_t> m_busySince{ 0 }; // 0 when the loop is idle
+    std::atomic<int> m_eventType{ 0 };
+    std::atomic<const char*> m_receiver{ nullptr };
+
+    // UI thread only
+    int m_depth = 0;        // dispatches in progress
+    int m_idleDepth = 0;    // depth at which the loop went idle last, the dispatch entered from it is timed
+    uint64_t m_stalls = 0;
+    int64_t m_totalMs = 0;
+    int64_t m_maxMs = 0;
+    std::deque<Stall> m_latest;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeUp;
+    bool m_stop = false;
+    std::thread m_thread;
+};
+
+// Passes every dispatch through the stall watchdog, when there is one
+class WatchedApplication : public QApplication
+{
+public:
+    using QApplication::QApplication;
+
+    bool notify(QObject* receiver, QEvent* event) override;
+};
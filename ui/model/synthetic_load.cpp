@@ -0,0 +1,404 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "synthetic_load.h"
+#include "wallet_model.h"
+#include "app_model.h"
+#include "event_monitor.h"
+#include "process_memory.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+#include <cstring>
+
+#include "utility/common.h"
+#include "utility/logger.h"
+
+using namespace beam;
+using namespace beam::wallet;
+
+namespace
+{
+    const char* kReportFileName = "ui_synthetic_load.json";
+
+    // separate id ranges, so generated items of different kinds never collide
+    const uint64_t kTxSeed = 0;
+    const uint64_t kOfferSeed = uint64_t(1) << 40;
+    const uint64_t kNotificationSeed = uint64_t(2) << 40;
+
+    template <typename T>
+    void fillId(T* data, size_t size, uint64_t index)
+    {
+        std::memset(data, 0, size);
+        std::memcpy(data, &index, std::min(size, sizeof(index)));
+    }
+
+    TxID txIdOf(uint64_t index)
+    {
+        TxID id;
+        fillId(id.data(), id.size(), index + 1);
+        return id;
+    }
+
+    WalletID walletIdOf(uint64_t index)
+    {
+        WalletID id;
+        fillId(id.m_Pk.m_pData, id.m_Pk.nBytes, index + 1);
+        id.m_Channel = 0u;
+        return id;
+    }
+}
+
+SyntheticLoad::Config SyntheticLoad::Config::parse(const QString& text)
+{
+    Config config;
+    const std::map<QString, int*> fields
+    {
+        { "tx",            &config.transactions },
+        { "utxo",          &config.utxos },
+        { "addr",          &config.addresses },
+        { "offers",        &config.offers },
+        { "notifications", &config.notifications },
+        { "rate",          &config.rate },
+        { "duration",      &config.duration },
+    };
+
+    for (const auto& item : text.split(',', QString::SkipEmptyParts))
+    {
+        const auto pair = item.split('=');
+        const auto key = pair.value(0).trimmed();
+        bool ok = false;
+        const int value = pair.value(1).trimmed().toInt(&ok);
+        if (!ok || value < 0)
+        {
+            LOG_WARNING() << "Synthetic load: bad value in " << item.toStdString();
+            continue;
+        }
+
+        if (key == "quit")
+        {
+            config.quit = value != 0;
+        }
+        else if (auto it = fields.find(key); it != fields.end())
+        {
+            *it->second = value;
+        }
+        else
+        {
+            LOG_WARNING() << "Synthetic load: unknown parameter " << key.toStdString();
+        }
+    }
+    config.rate = std::max(config.rate, 1);
+    return config;
+}
+
+SyntheticLoad::SyntheticLoad(WalletModel& model, const Config& config)
+    : m_model(model)
+    , m_config(config)
+    , m_started(Clock::now())
+    , m_random(42)
+{
+    // ingestion ends when the initial Reset has passed the receivers connected before this one
+    connect(&m_model, &WalletModel::transactionsChanged, this, [this] (ChangeAction action, const auto&) {
+        if (action == ChangeAction::Reset) onDelivered("transactions");
+    });
+    connect(&m_model, &WalletModel::allUtxoChanged, this, [this] (ChangeAction action, const auto&) {
+        if (action == ChangeAction::Reset) onDelivered("utxos");
+    });
+    connect(&m_model, QOverload<ChangeAction, const std::vector<WalletAddress>&>::of(&WalletModel::addressesChanged), this, [this] (ChangeAction action, const auto&) {
+        if (action == ChangeAction::Reset) onDelivered("addresses");
+    });
+#ifdef BEAM_ATOMIC_SWAP_SUPPORT
+    connect(&m_model, &WalletModel::swapOffersChanged, this, [this] (ChangeAction action, const auto&) {
+        if (action == ChangeAction::Reset) onDelivered("offers");
+    });
+#endif  // BEAM_ATOMIC_SWAP_SUPPORT
+    connect(&m_model, &WalletModel::notificationsChanged, this, [this] (ChangeAction action, const auto&) {
+        if (action == ChangeAction::Reset) onDelivered("notifications");
+    });
+
+    LOG_INFO() << "Synthetic load: " << m_config.transactions << " transactions, " << m_config.utxos << " utxos, "
+               << m_config.addresses << " addresses, " << m_config.offers << " offers, " << m_config.notifications
+               << " notifications, " << m_config.rate << " updates/s for " << m_config.duration << " s";
+
+    m_thread = std::thread([this] () { run(); });
+}
+
+SyntheticLoad::~SyntheticLoad()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeUp.notify_one();
+    m_thread.join();
+}
+
+void SyntheticLoad::run()
+{
+    loadInitial();
+
+    const auto interval = std::chrono::microseconds(1000000 / m_config.rate);
+    const auto end = Clock::now() + std::chrono::seconds(m_config.duration);
+    auto next = Clock::now();
+    for (int round = 0; ; ++round)
+    {
+        next += interval;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (m_wakeUp.wait_until(lock, std::min(next, end), [this] () { return m_stop; }))
+            {
+                return;
+            }
+        }
+        if (Clock::now() >= end)
+        {
+            break;
+        }
+        update(round);
+    }
+
+    QMetaObject::invokeMethod(this, [this] () { report(); }, Qt::QueuedConnection);
+}
+
+void SyntheticLoad::loadInitial()
+{
+    m_transactions.clear();
+    for (int i = 0; i < m_config.transactions; ++i)
+    {
+        m_transactions.push_back(makeTransaction(kTxSeed + i, TxStatus::Completed));
+    }
+    m_model.onTxStatus(ChangeAction::Reset, m_transactions);
+
+    m_utxos.clear();
+    for (int i = 0; i < m_config.utxos; ++i)
+    {
+        m_utxos.push_back(makeUtxo(i));
+    }
+    m_model.onAllUtxoChanged(ChangeAction::Reset, m_utxos);
+
+    std::vector<WalletAddress> addresses;
+    for (int i = 0; i < m_config.addresses; ++i)
+    {
+        addresses.push_back(makeAddress(i));
+    }
+    m_model.onAddressesChanged(ChangeAction::Reset, addresses);
+
+#ifdef BEAM_ATOMIC_SWAP_SUPPORT
+    std::vector<SwapOffer> offers;
+    for (int i = 0; i < m_config.offers; ++i)
+    {
+        offers.push_back(makeOffer(i));
+    }
+    m_model.onSwapOffersChanged(ChangeAction::Reset, offers);
+#endif  // BEAM_ATOMIC_SWAP_SUPPORT
+
+    std::vector<Notification> notifications;
+    for (int i = 0; i < m_config.notifications; ++i)
+    {
+        notifications.push_back(makeNotification(i));
+    }
+    m_model.onNotificationsChanged(ChangeAction::Reset, notifications);
+}
+
+void SyntheticLoad::update(int round)
+{
+    // every round moves one transaction forward and one coin between two states,
+    // new items and blocks come at lower rates, like on a busy wallet
+    if (!m_transactions.empty())
+    {
+        static const TxStatus kCycle[] = { TxStatus::Pending, TxStatus::InProgress, TxStatus::Registering, TxStatus::Completed };
+        auto& tx = m_transactions[m_random() % m_transactions.size()];
+        const auto it = std::find(std::begin(kCycle), std::end(kCycle), tx.m_status);
+        tx.m_status = it == std::end(kCycle) || it + 1 == std::end(kCycle) ? kCycle[0] : *(it + 1);
+        tx.m_modifyTime = getTimestamp();
+        tx.SetParameter(TxParameterID::Status, tx.m_status);
+        tx.SetParameter(TxParameterID::ModifyTime, tx.m_modifyTime);
+        m_model.onTxStatus(ChangeAction::Updated, { tx });
+    }
+
+    if (!m_utxos.empty())
+    {
+        auto& coin = m_utxos[m_random() % m_utxos.size()];
+        coin.m_status = coin.m_status == Coin::Available ? Coin::Outgoing : Coin::Available;
+        m_model.onAllUtxoChanged(ChangeAction::Updated, { coin });
+    }
+
+    if (round % 10 == 0)
+    {
+        m_transactions.push_back(makeTransaction(kTxSeed + m_transactions.size(), TxStatus::InProgress));
+        m_model.onTxStatus(ChangeAction::Added, { m_transactions.back() });
+    }
+
+    if (round % 50 == 0)
+    {
+#ifdef BEAM_ATOMIC_SWAP_SUPPORT
+        m_model.onSwapOffersChanged(ChangeAction::Added, { makeOffer(m_config.offers + round) });
+#endif  // BEAM_ATOMIC_SWAP_SUPPORT
+        m_model.onNotificationsChanged(ChangeAction::Added, { makeNotification(m_config.notifications + round) });
+    }
+
+    if (round % m_config.rate == 0)
+    {
+        WalletStatus status;
+        status.stateID.m_Height = ++m_height;
+        status.update.lastTime = getTimestamp();
+        auto& beamStatus = status.all[Asset::s_BeamID];
+        beamStatus.available = m_random() % 1000000000000;
+        beamStatus.receiving = m_random() % 100000000;
+        beamStatus.sending = m_random() % 100000000;
+        m_model.onStatus(status);
+
+        // reported with every block, the loading page waits for it and may open after the initial load
+        m_model.onSyncProgressUpdated(1, 1);
+    }
+}
+
+void SyntheticLoad::onDelivered(const char* kind)
+{
+    if (m_ingestionMs.count(kind))
+    {
+        return;
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - m_started).count();
+    m_ingestionMs[kind] = elapsed;
+    LOG_INFO() << "Synthetic load: " << kind << " ingested in " << elapsed << " ms";
+}
+
+void SyntheticLoad::report()
+{
+    QJsonObject config;
+    config.insert("transactions", m_config.transactions);
+    config.insert("utxos", m_config.utxos);
+    config.insert("addresses", m_config.addresses);
+    config.insert("offers", m_config.offers);
+    config.insert("notifications", m_config.notifications);
+    config.insert("rate", m_config.rate);
+    config.insert("duration", m_config.duration);
+
+    QJsonObject ingestion;
+    for (const auto& p : m_ingestionMs)
+    {
+        ingestion.insert(QString::fromStdString(p.first), static_cast<qint64>(p.second));
+    }
+
+    const auto peakRss = getPeakRss();
+    QJsonObject root;
+    root.insert("config", config);
+    root.insert("ingestion_ms", ingestion);
+    root.insert("peak_rss_bytes", static_cast<qint64>(peakRss));
+    root.insert("events", AppModel::getInstance().getEventMonitor().toJson().object());
+
+    const auto path = QDir(QString::fromStdString(AppModel::getInstance().getSettings().getAppDataPath()))
+        .filePath(QString(WalletSettings::LogsFolder) + "/" + kReportFileName);
+    QSaveFile file(path);
+    if (file.open(QIODevice::WriteOnly) && file.write(QJsonDocument(root).toJson()) >= 0 && file.commit())
+    {
+        LOG_INFO() << "Synthetic load finished, peak RSS " << peakRss / (1024 * 1024) << " MB, report: " << path.toStdString();
+    }
+    else
+    {
+        LOG_WARNING() << "Synthetic load finished, failed to write " << path.toStdString();
+    }
+
+    if (m_config.quit)
+    {
+        QCoreApplication::quit();
+    }
+}
+
+TxDescription SyntheticLoad::makeTransaction(uint64_t index, TxStatus status)
+{
+    TxDescription tx;
+    tx.m_txId = txIdOf(index);
+    tx.m_txType = TxType::Simple;
+    tx.m_amount = 1 + m_random() % 100000000000;
+    tx.m_fee = 100;
+    tx.m_assetId = Asset::s_BeamID;
+    tx.m_sender = index % 2 == 0;
+    tx.m_status = status;
+    tx.m_createTime = getTimestamp() - (m_config.transactions - std::min<uint64_t>(index, m_config.transactions)) * 60;
+    tx.m_modifyTime = tx.m_createTime;
+    tx.m_peerId = walletIdOf(index);
+    tx.m_myId = walletIdOf(index + 1);
+
+    // the views pick transactions by their parameters, as they come from the database
+    tx.SetParameter(TxParameterID::TransactionType, tx.m_txType);
+    tx.SetParameter(TxParameterID::Amount, tx.m_amount);
+    tx.SetParameter(TxParameterID::Fee, tx.m_fee);
+    tx.SetParameter(TxParameterID::AssetID, tx.m_assetId);
+    tx.SetParameter(TxParameterID::IsSender, tx.m_sender);
+    tx.SetParameter(TxParameterID::CreateTime, tx.m_createTime);
+    tx.SetParameter(TxParameterID::ModifyTime, tx.m_modifyTime);
+    tx.SetParameter(TxParameterID::PeerID, tx.m_peerId);
+    tx.SetParameter(TxParameterID::MyID, tx.m_myId);
+    tx.SetParameter(TxParameterID::Status, tx.m_status);
+    return tx;
+}
+
+Coin SyntheticLoad::makeUtxo(uint64_t index)
+{
+    Coin coin(1 + m_random() % 10000000000);
+    coin.m_ID.m_Idx = index;
+    coin.m_status = Coin::Available;
+    coin.m_confirmHeight = m_height;
+    coin.m_maturity = m_height;
+    return coin;
+}
+
+WalletAddress SyntheticLoad::makeAddress(uint64_t index)
+{
+    WalletAddress address;
+    address.m_walletID = walletIdOf(index);
+    address.m_label = "synthetic " + std::to_string(index);
+    address.m_createTime = getTimestamp();
+    address.m_duration = WalletAddress::AddressExpirationNever;
+    address.m_OwnID = index % 2 == 0 ? index + 1 : 0;
+    return address;
+}
+
+#ifdef BEAM_ATOMIC_SWAP_SUPPORT
+SwapOffer SyntheticLoad::makeOffer(uint64_t index)
+{
+    SwapOffer offer(txIdOf(kOfferSeed + index));
+    offer.m_status = SwapOfferStatus::Pending;
+    offer.m_publisherId = walletIdOf(kOfferSeed + index);
+    offer.m_coin = AtomicSwapCoin::Bitcoin;
+    offer.m_isOwn = false;
+    offer.SetParameter(TxParameterID::AtomicSwapCoin, AtomicSwapCoin::Bitcoin);
+    offer.SetParameter(TxParameterID::AtomicSwapIsBeamSide, index % 2 == 0);
+    offer.SetParameter(TxParameterID::Amount, Amount(1 + m_random() % 100000000000));
+    offer.SetParameter(TxParameterID::AtomicSwapAmount, Amount(1 + m_random() % 100000000));
+    offer.SetParameter(TxParameterID::CreateTime, getTimestamp());
+    offer.SetParameter(TxParameterID::MinHeight, m_height);
+    offer.SetParameter(TxParameterID::PeerResponseTime, Height(1440));
+    return offer;
+}
+#endif  // BEAM_ATOMIC_SWAP_SUPPORT
+
+Notification SyntheticLoad::makeNotification(uint64_t index)
+{
+    Notification notification;
+    fillId(notification.m_ID.m_pData, notification.m_ID.nBytes, kNotificationSeed + index);
+    notification.m_type = Notification::Type::AddressStatusChanged;
+    notification.m_state = Notification::State::Unread;
+    notification.m_createTime = getTimestamp();
+    notification.m_content = toByteBuffer(makeAddress(index));
+    return notification;
+}
@@ -0,0 +1,95 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QObject>
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "wallet/client/wallet_client.h"
+
+class WalletModel;
+
+// Feeds WalletModel with generated wallet events from its own thread, the same way
+// the reactor does, so the view models and their proxies can be measured on a known data set.
+// Enabled by debug/synthetic_load in settings.ini, for example
+//     tx=10000,utxo=5000,addr=1000,offers=500,notifications=200,rate=50,duration=60,quit=1
+// Neither the node nor the wallet client are started then, the generated events are the only
+// ones the UI gets and the wallet database is not read.
+// With QT_QPA_PLATFORM=offscreen and quit=1 the run is headless and the application exits
+// after writing logs/ui_synthetic_load.json with ingestion times, the EventMonitor statistics
+// (per-update latency, handler, filter and sort times) and the peak RSS
+class SyntheticLoad : public QObject
+{
+    Q_OBJECT
+public:
+    struct Config
+    {
+        int transactions = 1000;
+        int utxos = 1000;
+        int addresses = 100;
+        int offers = 100;
+        int notifications = 50;
+        int rate = 20;          // update rounds per second
+        int duration = 30;      // seconds of updates after the initial load
+        bool quit = false;
+
+        static Config parse(const QString& text);
+    };
+
+    SyntheticLoad(WalletModel& model, const Config& config);
+    ~SyntheticLoad() override;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void run();
+    void loadInitial();
+    void update(int round);
+    void onDelivered(const char* kind);
+    void report();
+
+    beam::wallet::TxDescription makeTransaction(uint64_t index, beam::wallet::TxStatus status);
+    beam::wallet::Coin makeUtxo(uint64_t index);
+    beam::wallet::WalletAddress makeAddress(uint64_t index);
+#ifdef BEAM_ATOMIC_SWAP_SUPPORT
+    beam::wallet::SwapOffer makeOffer(uint64_t index);
+#endif  // BEAM_ATOMIC_SWAP_SUPPORT
+    beam::wallet::Notification makeNotification(uint64_t index);
+
+    WalletModel& m_model;
+    const Config m_config;
+
+    Clock::time_point m_started;
+    std::map<std::string, int64_t> m_ingestionMs;   // UI thread only
+
+    // generator thread only
+    std::mt19937_64 m_random;
+    beam::Height m_height = 1;
+    std::vector<beam::wallet::TxDescription> m_transactions;
+    std::vector<beam::wallet::Coin> m_utxos;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeUp;
+    bool m_stop = false;
+    std::thread m_thread;
+};
@@ -14,6 +14,10 @@
 
 #include "wallet_model.h"
 #include "app_model.h"
+#include "event_monitor.h"
+#if defined(BEAM_UI_PROFILING)
+#include "callback_trace.h"
+#endif
 #include "utility/logger.h"
 #include "utility/bridge.h"
 #include "utility/io/asyncevent.h"
@@ -25,8 +29,81 @@ using namespace beam::wallet;
 using namespace beam::io;
 using namespace std;
 
+namespace
+{
+    // one frame at 60 fps
+    const int kDefaultCoalescingWindowMs = 16;
+
+    // What the wallet builds and registers a transaction with. Rows, filters and details
+    // never read it, the payment proof is exported from the database when it is shown
+    bool isBuildingParameter(TxParameterID id)
+    {
+        switch (id)
+        {
+        case TxParameterID::Inputs:
+        case TxParameterID::Outputs:
+        case TxParameterID::Kernel:
+        case TxParameterID::Offset:
+        case TxParameterID::BlindingExcess:
+        case TxParameterID::PeerInputs:
+        case TxParameterID::PeerOutputs:
+        case TxParameterID::PeerOffset:
+        case TxParameterID::PeerPublicExcess:
+        case TxParameterID::PeerPublicNonce:
+        case TxParameterID::PeerSignature:
+        case TxParameterID::PaymentConfirmation:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // the store copy of a transaction, the fields and the parameters the views read
+    WalletModel::TxPtr makeStored(const TxDescription& tx)
+    {
+        TxParameters params(tx.GetTxID());
+        SubTxID subTxID = kDefaultSubTxID;
+        for (const auto& p : tx.Pack())
+        {
+            if (p.first == TxParameterID::SubTxIndex)
+            {
+                // the parameters which follow belong to this sub transaction
+                fromByteBuffer(p.second, subTxID);
+            }
+            else if (!isBuildingParameter(p.first))
+            {
+                params.SetParameter(p.first, p.second, subTxID);
+            }
+        }
+
+        auto stored = std::make_shared<TxDescription>(tx);
+        static_cast<TxParameters&>(*stored) = std::move(params);
+        return stored;
+    }
+}
+
 WalletModel::WalletModel(IWalletDB::Ptr walletDB, const std::string& nodeAddr, beam::io::Reactor::Ptr reactor)
     : WalletClient(walletDB, nodeAddr, reactor)
+    , m_pendingTransactions([](const auto& tx) { return tx.m_txId; })
+    , m_pendingUtxos([](const auto& coin)
+        {
+            ECC::Hash::Value hv;
+            coin.m_ID.get_Hash(hv);
+            return hv;
+        })
+    , m_pendingShieldedCoins([](const auto& coin)
+        {
+            // the same identity as the UI shielded coin items use
+            ECC::Hash::Processor hp;
+            hp << coin.m_TxoID
+               << coin.m_CoinID.m_Value
+               << coin.m_CoinID.m_AssetID;
+            ECC::Hash::Value hv;
+            hp >> hv;
+            return hv;
+        })
+    , m_pendingAddresses([](const auto& address) { return address.m_walletID; })
+    , m_coalescingWindow(kDefaultCoalescingWindowMs)
 {
     qRegisterMetaType<beam::ByteBuffer>("beam::ByteBuffer");
     qRegisterMetaType<beam::wallet::WalletStatus>("beam::wallet::WalletStatus");
@@ -50,9 +127,11 @@ WalletModel::WalletModel(IWalletDB::Ptr walletDB, const std::string& nodeAddr, b
     qRegisterMetaType<boost::optional<beam::wallet::WalletAddress>>("boost::optional<beam::wallet::WalletAddress>");
     qRegisterMetaType<beam::wallet::ShieldedCoinsSelectionInfo>("beam::wallet::ShieldedCoinsSelectionInfo");
 
-    connect(this, &WalletModel::walletStatusInternal, this, &WalletModel::onWalletStatusInternal);
+    m_flushTimer.setSingleShot(true);
+    connect(&m_flushTimer, &QTimer::timeout, this, &WalletModel::flushChanges);
+    connect(this, &WalletModel::changesPending, this, &WalletModel::onChangesPending);
     connect(this, SIGNAL(addressesChanged(bool, const std::vector<beam::wallet::WalletAddress>&)),this, SLOT(setAddresses(bool, const std::vector<beam::wallet::WalletAddress>&)));
-    connect(this, SIGNAL(functionPosted(const std::function<void()>&)), this, SLOT(doFunction(const std::function<void()>&)));
+    connect(this, &WalletModel::functionsPending, this, &WalletModel::drainFunctions);
 
     getAsync()->getAddresses(true);
 }
@@ -119,47 +198,88 @@ bool WalletModel::isAddressWithCommentExist(const std::string& comment) const
 
 void WalletModel::onStatus(const beam::wallet::WalletStatus& status)
 {
-    emit walletStatusInternal(status);
+#if defined(BEAM_UI_PROFILING)
+    if (m_recorder)
+    {
+        m_recorder->onStatus(status);
+    }
+#endif
+    addPendingChanges("onStatus", [&] () { m_pendingStatus = status; });
 }
 
 void WalletModel::onTxStatus(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& items)
 {
-    emit transactionsChanged(action, items);
+#if defined(BEAM_UI_PROFILING)
+    if (m_recorder)
+    {
+        m_recorder->onTxStatus(action, items);
+    }
+#endif
+    addPendingChanges("onTxStatus", [&] () { m_pendingTransactions.add(action, items); });
 }
 
 void WalletModel::onSyncProgressUpdated(int done, int total)
 {
-    emit syncProgressUpdated(done, total);
+#if defined(BEAM_UI_PROFILING)
+    if (m_recorder)
+    {
+        m_recorder->onSyncProgressUpdated(done, total);
+    }
+#endif
+    postFunction([this, done, total]() { emit syncProgressUpdated(done, total); }, "onSyncProgressUpdated");
 }
 
 void WalletModel::onChangeCalculated(beam::Amount changeAsset, beam::Amount changeBeam, beam::Asset::ID assetId)
 {
-    emit changeCalculated(changeAsset, changeBeam, assetId);
+    postFunction([this, changeAsset, changeBeam, assetId]() { emit changeCalculated(changeAsset, changeBeam, assetId); }, "onChangeCalculated");
 }
 
 void WalletModel::onShieldedCoinsSelectionCalculated(const ShieldedCoinsSelectionInfo& selectionRes)
 {
-    emit shieldedCoinsSelectionCalculated(selectionRes);
+    postFunction([this, selectionRes]() { emit shieldedCoinsSelectionCalculated(selectionRes); }, "onShieldedCoinsSelectionCalculated");
 }
 
 void WalletModel::onNeedExtractShieldedCoins(bool val)
 {
-    emit needExtractShieldedCoins(val);
+    postFunction([this, val]() { emit needExtractShieldedCoins(val); }, "onNeedExtractShieldedCoins");
 }
 
 void WalletModel::onAllUtxoChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::Coin>& utxos)
 {
-    emit allUtxoChanged(action, utxos);
+#if defined(BEAM_UI_PROFILING)
+    if (m_recorder)
+    {
+        m_recorder->onAllUtxoChanged(action, utxos);
+    }
+#endif
+    addPendingChanges("onAllUtxoChanged", [&] () { m_pendingUtxos.add(action, utxos); });
 }
 
 void WalletModel::onShieldedCoinChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::ShieldedCoin>& items)
 {
 #ifdef BEAM_LELANTUS_SUPPORT
-    emit shieldedCoinChanged(action, items);
+#if defined(BEAM_UI_PROFILING)
+    if (m_recorder)
+    {
+        m_recorder->onShieldedCoinChanged(action, items);
+    }
+#endif
+    addPendingChanges("onShieldedCoinChanged", [&] () { m_pendingShieldedCoins.add(action, items); });
 #endif
 }
 
 void WalletModel::onAddressesChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::WalletAddress>& items)
+{
+#if defined(BEAM_UI_PROFILING)
+    if (m_recorder)
+    {
+        m_recorder->onAddressesChanged(action, items);
+    }
+#endif
+    addPendingChanges("onAddressesChanged", [&] () { m_pendingAddresses.add(action, items); });
+}
+
+void WalletModel::onAddressesChangedInternal(beam::wallet::ChangeAction action, const std::vector<beam::wallet::WalletAddress>& items)
 {
     emit addressesChanged(action, items);
     for (const auto& item : items)
@@ -182,13 +302,26 @@ void WalletModel::onAddressesChanged(beam::wallet::ChangeAction action, const st
 
 void WalletModel::onAddresses(bool own, const std::vector<beam::wallet::WalletAddress>& addrs)
 {
-    emit addressesChanged(own, addrs);
+#if defined(BEAM_UI_PROFILING)
+    if (m_recorder)
+    {
+        m_recorder->onAddresses(own, addrs);
+    }
+#endif
+    // the batch is copied once into the posted function and emitted on the UI thread, all receivers read the same buffer
+    postFunction([this, own, batch = addrs]() { emit addressesChanged(own, batch); }, "onAddresses");
 }
 
 #ifdef BEAM_ATOMIC_SWAP_SUPPORT
 void WalletModel::onSwapOffersChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::SwapOffer>& offers)
 {
-    emit swapOffersChanged(action, offers);
+#if defined(BEAM_UI_PROFILING)
+    if (m_recorder)
+    {
+        m_recorder->onSwapOffersChanged(action, offers);
+    }
+#endif
+    postFunction([this, action, batch = offers]() { emit swapOffersChanged(action, batch); }, "onSwapOffersChanged");
 }
 #endif  // BEAM_ATOMIC_SWAP_SUPPORT
 
@@ -198,7 +331,7 @@ void WalletModel::onCoinsByTx(const std::vector<beam::wallet::Coin>& coins)
 
 void WalletModel::onAddressChecked(const std::string& addr, bool isValid)
 {
-    emit addressChecked(QString::fromStdString(addr), isValid);
+    postFunction([this, addr = QString::fromStdString(addr), isValid]() { emit addressChecked(addr, isValid); }, "onAddressChecked");
 }
 
 void WalletModel::onImportRecoveryProgress(uint64_t done, uint64_t total)
@@ -208,45 +341,48 @@ void WalletModel::onImportRecoveryProgress(uint64_t done, uint64_t total)
 #if defined(BEAM_HW_WALLET)
 void WalletModel::ShowKeyKeeperMessage()
 {
-    emit showTrezorMessage();
+    postFunction([this]() { emit showTrezorMessage(); }, "ShowKeyKeeperMessage");
 }
 
 void WalletModel::HideKeyKeeperMessage()
 {
-    emit hideTrezorMessage();
+    postFunction([this]() { emit hideTrezorMessage(); }, "HideKeyKeeperMessage");
 }
 
 void WalletModel::ShowKeyKeeperError(const std::string& error)
 {
-    emit showTrezorError(QString::fromStdString(error));
+    postFunction([this, error = QString::fromStdString(error)]() { emit showTrezorError(error); }, "ShowKeyKeeperError");
 }
 #endif
 
 void WalletModel::onSwapParamsLoaded(const beam::ByteBuffer& params)
 {
-    emit swapParamsLoaded(params);
+    postFunction([this, params]() { emit swapParamsLoaded(params); }, "onSwapParamsLoaded");
 }
 
 void WalletModel::onGeneratedNewAddress(const beam::wallet::WalletAddress& walletAddr)
 {
-    emit generatedNewAddress(walletAddr);
+    postFunction([this, walletAddr]() { emit generatedNewAddress(walletAddr); }, "onGeneratedNewAddress");
 }
 
 void WalletModel::onGetAddress(const WalletID& id, const boost::optional<beam::wallet::WalletAddress>& address, size_t offlinePayments)
 {
-    emit getAddressReturned(id, address, (int)offlinePayments);
+    postFunction([this, id, address, offlinePayments]() { emit getAddressReturned(id, address, (int)offlinePayments); }, "onGetAddress");
 }
 
 void WalletModel::onNewAddressFailed()
 {
-    emit newAddressFailed();
+    postFunction([this]() { emit newAddressFailed(); }, "onNewAddressFailed");
 }
 
 void WalletModel::onNoDeviceConnected()
 {
 #if defined(BEAM_HW_WALLET)
-    //% "There is no Trezor device connected. Please, connect and try again."
-    showTrezorError(qtTrId("wallet-model-device-not-connected"));
+    postFunction([this]()
+    {
+        //% "There is no Trezor device connected. Please, connect and try again."
+        emit showTrezorError(qtTrId("wallet-model-device-not-connected"));
+    }, "onNoDeviceConnected");
 #endif
 }
 
@@ -260,17 +396,23 @@ void WalletModel::onExportDataToJson(const std::string& data)
 
 void WalletModel::onExportTxHistoryToCsv(const std::string& data)
 {
-    emit txHistoryExportedToCsv(QString::fromStdString(data));
+    postFunction([this, data = QString::fromStdString(data)]() { emit txHistoryExportedToCsv(data); }, "onExportTxHistoryToCsv");
 }
 
 void WalletModel::onNodeConnectionChanged(bool isNodeConnected)
 {
-    emit nodeConnectionChanged(isNodeConnected);
+#if defined(BEAM_UI_PROFILING)
+    if (m_recorder)
+    {
+        m_recorder->onNodeConnectionChanged(isNodeConnected);
+    }
+#endif
+    postFunction([this, isNodeConnected]() { emit nodeConnectionChanged(isNodeConnected); }, "onNodeConnectionChanged");
 }
 
 void WalletModel::onWalletError(beam::wallet::ErrorType error)
 {
-    emit walletError(error);
+    postFunction([this, error]() { emit walletError(error); }, "onWalletError");
 }
 
 void WalletModel::FailedToStartWallet()
@@ -281,12 +423,12 @@ void WalletModel::FailedToStartWallet()
 
 void WalletModel::onSendMoneyVerified()
 {
-    emit sendMoneyVerified();
+    postFunction([this]() { emit sendMoneyVerified(); }, "onSendMoneyVerified");
 }
 
 void WalletModel::onCantSendToExpired()
 {
-    emit cantSendToExpired();
+    postFunction([this]() { emit cantSendToExpired(); }, "onCantSendToExpired");
 }
 
 void WalletModel::onPaymentProofExported(const beam::wallet::TxID& txID, const beam::ByteBuffer& proof)
@@ -295,32 +437,64 @@ void WalletModel::onPaymentProofExported(const beam::wallet::TxID& txID, const b
     str.resize(proof.size() * 2);
 
     beam::to_hex(str.data(), proof.data(), proof.size());
-    emit paymentProofExported(txID, QString::fromStdString(str));
+    postFunction([this, txID, proof = QString::fromStdString(str)]() { emit paymentProofExported(txID, proof); }, "onPaymentProofExported");
 }
 
 void WalletModel::onPostFunctionToClientContext(MessageFunction&& func)
 {
-    emit functionPosted(func);
+    postFunction(std::move(func), "onPostFunctionToClientContext");
+}
+
+bool WalletModel::sealPendingChanges()
+{
+    if (auto changes = takePendingChanges(); !changes.empty())
+    {
+        return m_functions.push([this, sealed = std::move(changes)]() { deliverChanges(sealed); }, "pendingChanges");
+    }
+    return false;
+}
+
+FunctionQueue::Stats WalletModel::getPostedFunctionStats() const
+{
+    return m_functions.stats();
 }
 
 void WalletModel::onExchangeRates(const std::vector<beam::wallet::ExchangeRate>& rates)
 {
-    emit exchangeRatesUpdate(rates);
+#if defined(BEAM_UI_PROFILING)
+    if (m_recorder)
+    {
+        m_recorder->onExchangeRates(rates);
+    }
+#endif
+    postFunction([this, batch = rates]() { emit exchangeRatesUpdate(batch); }, "onExchangeRates");
 }
 
 void WalletModel::onNotificationsChanged(beam::wallet::ChangeAction action, const std::vector<Notification>& notifications)
 {
-    emit notificationsChanged(action, notifications);
+#if defined(BEAM_UI_PROFILING)
+    if (m_recorder)
+    {
+        m_recorder->onNotificationsChanged(action, notifications);
+    }
+#endif
+    postFunction([this, action, batch = notifications]() { emit notificationsChanged(action, batch); }, "onNotificationsChanged");
 }
 
 void WalletModel::onPublicAddress(const std::string& publicAddr)
 {
-    emit publicAddressChanged(QString::fromStdString(publicAddr));
+    postFunction([this, publicAddr = QString::fromStdString(publicAddr)]() { emit publicAddressChanged(publicAddr); }, "onPublicAddress");
 }
 
 void WalletModel::onAssetInfo(beam::Asset::ID assetId, const WalletAsset& info)
 {
-    emit assetInfoChanged(assetId, info);
+#if defined(BEAM_UI_PROFILING)
+    if (m_recorder)
+    {
+        m_recorder->onAssetInfo(assetId, info);
+    }
+#endif
+    postFunction([this, assetId, info]() { emit assetInfoChanged(assetId, info); }, "onAssetInfo");
 }
 
 beam::Version WalletModel::getLibVersion() const
@@ -409,10 +583,274 @@ bool WalletModel::hasShielded(beam::Asset::ID id) const
 
 void WalletModel::onWalletStatusInternal(const beam::wallet::WalletStatus& newStatus)
 {
+    // a new block usually leaves the balances as they are, so subscribers are told what exactly has changed
+    const bool heightUpdated = newStatus.stateID != m_status.stateID;
+    const bool timeUpdated = newStatus.update.lastTime != m_status.update.lastTime;
+
+    std::set<beam::Asset::ID> changedAssets;
+    for (const auto& p : newStatus.all)
+    {
+        const auto it = m_status.all.find(p.first);
+        if (it == m_status.all.end() || !isSameBalance(it->second, p.second))
+        {
+            changedAssets.insert(p.first);
+        }
+    }
+    for (const auto& p : m_status.all)
+    {
+        if (newStatus.all.find(p.first) == newStatus.all.end())
+        {
+            changedAssets.insert(p.first);
+        }
+    }
+
     m_status = newStatus;
+
+    if (!heightUpdated && !timeUpdated && changedAssets.empty())
+    {
+        return;
+    }
+
+    if (heightUpdated)
+    {
+        emit heightChanged();
+    }
+    if (!changedAssets.empty())
+    {
+        for (const auto assetId : changedAssets)
+        {
+            emit assetBalanceChanged(assetId);
+        }
+        emit balancesChanged(changedAssets);
+    }
     emit walletStatusChanged();
 }
 
+bool WalletModel::isSameBalance(const beam::wallet::WalletStatus::AssetStatus& left, const beam::wallet::WalletStatus::AssetStatus& right)
+{
+    return left.available         == right.available
+        && left.receivingIncoming == right.receivingIncoming
+        && left.receivingChange   == right.receivingChange
+        && left.receiving         == right.receiving
+        && left.sending           == right.sending
+        && left.maturing          == right.maturing
+        && left.maturingMP        == right.maturingMP
+        && left.shielded          == right.shielded;
+}
+
+void WalletModel::onTransactionsChangedInternal(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& items)
+{
+    switch (action)
+    {
+    case ChangeAction::Reset:
+        m_transactions.clear();
+        m_txLoaded = true;
+        [[fallthrough]];
+    case ChangeAction::Added:
+    case ChangeAction::Updated:
+        for (const auto& tx : items)
+        {
+            m_transactions[tx.m_txId] = makeStored(tx);
+        }
+        break;
+    case ChangeAction::Removed:
+        for (const auto& tx : items)
+        {
+            m_transactions.erase(tx.m_txId);
+        }
+        break;
+    }
+
+    emit transactionsChanged(action, items);
+}
+
+void WalletModel::setCoalescingWindow(int ms)
+{
+    m_coalescingWindow = ms;
+}
+
+#if defined(BEAM_UI_PROFILING)
+void WalletModel::recordCallbacks(const QString& path)
+{
+    assert(!isRunning());
+    m_recorder = std::make_unique<CallbackRecorder>(path);
+}
+#endif
+
+void WalletModel::addPendingChanges(const char* event, const std::function<void()>& add)
+{
+    bool schedule = false;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        add();
+        // the oldest change of a kind is what the UI is late for
+        m_pendingSince.emplace(event, std::chrono::steady_clock::now());
+        schedule = !m_flushScheduled;
+        m_flushScheduled = true;
+    }
+
+    if (schedule)
+    {
+        emit changesPending();
+    }
+}
+
+void WalletModel::onChangesPending()
+{
+    if (!m_flushTimer.isActive())
+    {
+        m_flushTimer.start(m_coalescingWindow);
+    }
+}
+
+void WalletModel::flushChanges()
+{
+    // the queued functions came before the changes pending now, see postFunction()
+    drainFunctions();
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_flushScheduled = false;
+    }
+    deliverChanges(takePendingChanges());
+}
+
+auto WalletModel::takePendingChanges() -> PendingChanges
+{
+    PendingChanges changes;
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    changes.since.swap(m_pendingSince);
+    changes.status.swap(m_pendingStatus);
+    changes.addresses = m_pendingAddresses.take();
+    changes.utxos = m_pendingUtxos.take();
+    changes.shieldedCoins = m_pendingShieldedCoins.take();
+    changes.transactions = m_pendingTransactions.take();
+    return changes;
+}
+
+bool WalletModel::PendingChanges::empty() const
+{
+    return since.empty();
+}
+
+void WalletModel::deliverChanges(const PendingChanges& changes)
+{
+    if (auto monitor = EventMonitor::getInstance())
+    {
+        const auto now = std::chrono::steady_clock::now();
+        for (const auto& p : changes.since)
+        {
+            monitor->addLatency(p.first, now - p.second);
+        }
+    }
+
+    if (changes.status)
+    {
+        onWalletStatusInternal(*changes.status);
+    }
+    // signals are emitted on the UI thread, so receivers get references to the taken batches without copies
+    for (const auto& batch : changes.addresses)
+    {
+        onAddressesChangedInternal(batch.first, batch.second);
+    }
+    for (const auto& batch : changes.utxos)
+    {
+        emit allUtxoChanged(batch.first, batch.second);
+    }
+#ifdef BEAM_LELANTUS_SUPPORT
+    for (const auto& batch : changes.shieldedCoins)
+    {
+        emit shieldedCoinChanged(batch.first, batch.second);
+    }
+#endif
+    for (const auto& batch : changes.transactions)
+    {
+        onTransactionsChangedInternal(batch.first, batch.second);
+    }
+}
+
+void WalletModel::loadTransactions()
+{
+    if (m_txRequested)
+    {
+        return;
+    }
+    m_txRequested = true;
+    getAsync()->getTransactions();
+}
+
+bool WalletModel::isTransactionsLoaded() const
+{
+    return m_txLoaded;
+}
+
+auto WalletModel::getTransactions(TxKind kind) const -> TxList
+{
+    TxList transactions;
+    transactions.reserve(m_transactions.size());
+    for (const auto& p : m_transactions)
+    {
+        if (isTxKind(*p.second, kind))
+        {
+            transactions.push_back(p.second);
+        }
+    }
+    return transactions;
+}
+
+auto WalletModel::getTransactions(const std::vector<beam::wallet::TxDescription>& items, TxKind kind) const -> TxList
+{
+    TxList transactions;
+    transactions.reserve(items.size());
+    for (const auto& tx : items)
+    {
+        if (!isTxKind(tx, kind))
+        {
+            continue;
+        }
+
+        if (auto it = m_transactions.find(tx.m_txId); it != m_transactions.end())
+        {
+            transactions.push_back(it->second);
+        }
+        else
+        {
+            transactions.push_back(makeStored(tx));
+        }
+    }
+    return transactions;
+}
+
+bool WalletModel::isTxKind(const beam::wallet::TxDescription& tx, TxKind kind)
+{
+    if (kind == TxKind::Any)
+    {
+        return true;
+    }
+
+    const auto txType = tx.GetParameter<TxType>(TxParameterID::TransactionType);
+    if (!txType)
+    {
+        return false;
+    }
+
+    switch (*txType)
+    {
+    case TxType::Simple:
+    case TxType::PushTransaction:
+        return kind == TxKind::Simple;
+    case TxType::AtomicSwap:
+        return kind == TxKind::Swap;
+    case TxType::AssetIssue:
+    case TxType::AssetConsume:
+    case TxType::AssetReg:
+    case TxType::AssetUnreg:
+    case TxType::AssetInfo:
+        return kind == TxKind::Asset;
+    default:
+        return false;
+    }
+}
+
 void WalletModel::setAddresses(bool own, const std::vector<beam::wallet::WalletAddress>& addrs)
 {
     if (own)
@@ -428,7 +866,14 @@ void WalletModel::setAddresses(bool own, const std::vector<beam::wallet::WalletA
     }
 }
 
-void WalletModel::doFunction(const std::function<void()>& func)
+void WalletModel::drainFunctions()
 {
-    func();
+    auto monitor = EventMonitor::getInstance();
+    m_functions.drain([monitor] (const char* event, FunctionQueue::Clock::duration wait)
+    {
+        if (monitor && event)
+        {
+            monitor->addLatency(event, wait);
+        }
+    });
 }
@@ -15,15 +15,26 @@
 #pragma once
 
 #include <QObject>
+#include <QTimer>
 
 #include "wallet/client/wallet_client.h"
+#include "change_coalescer.h"
+#include "function_queue.h"
 
 #ifdef BEAM_HW_WALLET
 #include "keykeeper/hw_wallet.h"
 #endif
 
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 
+#if defined(BEAM_UI_PROFILING)
+class CallbackRecorder;
+#endif
+
 class WalletModel
     : public QObject
     , public beam::wallet::WalletClient
@@ -34,6 +45,17 @@ class WalletModel
     Q_OBJECT
 public:
     using Ptr = std::shared_ptr<WalletModel>;
+    using TxPtr = std::shared_ptr<const beam::wallet::TxDescription>;
+    using TxList = std::vector<TxPtr>;
+
+    // Typed views of the transaction store
+    enum class TxKind
+    {
+        Any,
+        Simple, // simple and shielded push transactions
+        Swap,
+        Asset
+    };
     WalletModel(beam::wallet::IWalletDB::Ptr walletDB, const std::string& nodeAddr, beam::io::Reactor::Ptr reactor);
     ~WalletModel() override;
 
@@ -51,9 +73,29 @@ public:
     beam::Amount getMatutingMP(beam::Asset::ID) const;
     bool hasShielded(beam::Asset::ID) const;
 
+    // Transactions are read from the wallet DB once and kept current from onTxStatus deltas.
+    // View models take the current set when they attach and follow transactionsChanged,
+    // loadTransactions() only reads the DB the first time and its Reset goes to all subscribers.
+    // The descriptions are shared with the view models, they are never copied out of the store
+    void loadTransactions();
+    bool isTransactionsLoaded() const;
+    TxList getTransactions(TxKind kind = TxKind::Any) const;
+    // stored descriptions of the transactionsChanged items, removed items are not in the store any more
+    TxList getTransactions(const std::vector<beam::wallet::TxDescription>& items, TxKind kind = TxKind::Any) const;
+    static bool isTxKind(const beam::wallet::TxDescription& tx, TxKind kind);
+
+    // Reactor notifications which come within this window are merged and delivered at once
+    void setCoalescingWindow(int ms);
+
+#if defined(BEAM_UI_PROFILING)
+    // Writes the state callbacks to a trace file, see CallbackRecorder. Call before the client is started
+    void recordCallbacks(const QString& path);
+#endif
+
     beam::Height getCurrentHeight() const;
     beam::Timestamp getCurrentHeightTimestamp() const;
     beam::Block::SystemState::ID getCurrentStateID() const;
+    FunctionQueue::Stats getPostedFunctionStats() const;
 
 signals:
     // INTERNAL SIGNALS, DO NOT SUBSCRIBE IN OTHER UI OBJECTS.
@@ -61,10 +103,16 @@ signals:
     // These are used to redirect from reactor thread to the UI thread
     // and cache some data. Due to old designed getters (getAvailable &c.).
     // Better to avoid such internal signals
-    void walletStatusInternal(const beam::wallet::WalletStatus& status);
+    void changesPending();
+    void functionsPending();
 
     // Public Signal
+    // walletStatusChanged is emitted when anything in the status changes,
+    // the signals below narrow it down to the tip and to the balances of particular assets
     void walletStatusChanged();
+    void heightChanged();
+    void assetBalanceChanged(beam::Asset::ID assetId);
+    void balancesChanged(const std::set<beam::Asset::ID>& assets);
     void assetInfoChanged(beam::Asset::ID assetId, const beam::wallet::WalletAsset& info);
 
 signals:
@@ -90,7 +138,6 @@ signals:
     void cantSendToExpired();
     void paymentProofExported(const beam::wallet::TxID& txID, const QString& proof);
     void addressChecked(const QString& addr, bool isValid);
-    void functionPosted(const std::function<void()>&);
 #if defined(BEAM_HW_WALLET)
     void showTrezorMessage();
     void hideTrezorMessage();
@@ -102,6 +149,10 @@ signals:
     void notificationsChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::Notification>&);
     void publicAddressChanged(const QString& publicAddr);
 private:
+    // inject generated or recorded reactor events for profiling
+    friend class SyntheticLoad;
+    friend class CallbackReplay;
+
     void onStatus(const beam::wallet::WalletStatus& status) override;
     void onTxStatus(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>& items) override;
     void onSyncProgressUpdated(int done, int total) override;
@@ -146,12 +197,73 @@ private:
     uint32_t getClientRevision() const override;
 
 private slots:
-    void onWalletStatusInternal(const beam::wallet::WalletStatus& status);
+    void onChangesPending();
+    void flushChanges();
     void setAddresses(bool own, const std::vector<beam::wallet::WalletAddress>& addrs);
-    void doFunction(const std::function<void()>& func);
+    void drainFunctions();
 
 private:
+    // Coalesced reactor callbacks, taken at once. postFunction() seals the changes which came
+    // before the function, so only the callbacks between two posted functions are merged
+    struct PendingChanges
+    {
+        std::map<const char*, std::chrono::steady_clock::time_point> since;
+        boost::optional<beam::wallet::WalletStatus> status;
+        std::vector<ChangeCoalescer<beam::wallet::WalletAddress, beam::wallet::WalletID>::Batch> addresses;
+        std::vector<ChangeCoalescer<beam::wallet::Coin, ECC::Hash::Value>::Batch> utxos;
+        std::vector<ChangeCoalescer<beam::wallet::ShieldedCoin, ECC::Hash::Value>::Batch> shieldedCoins;
+        std::vector<ChangeCoalescer<beam::wallet::TxDescription, beam::wallet::TxID>::Batch> transactions;
+
+        bool empty() const;
+    };
+
+    void addPendingChanges(const char* event, const std::function<void()>& add);
+    PendingChanges takePendingChanges();
+    void deliverChanges(const PendingChanges& changes);
+    // changes which came before the function are delivered before it runs,
+    // so receivers see the callbacks of all kinds in the order they came
+    template <typename Func>
+    void postFunction(Func&& func, const char* event)
+    {
+        const bool sealed = sealPendingChanges();
+        // one event is posted per batch, functions pushed before it is handled are run by the same drain
+        if (m_functions.push(std::forward<Func>(func), event) || sealed)
+        {
+            emit functionsPending();
+        }
+    }
+    // queues the pending changes for delivery, returns true if the queue was empty
+    bool sealPendingChanges();
+    void onWalletStatusInternal(const beam::wallet::WalletStatus& status);
+    static bool isSameBalance(const beam::wallet::WalletStatus::AssetStatus& left, const beam::wallet::WalletStatus::AssetStatus& right);
+    void onTransactionsChangedInternal(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& items);
+    void onAddressesChangedInternal(beam::wallet::ChangeAction action, const std::vector<beam::wallet::WalletAddress>& items);
+
     std::set<beam::wallet::WalletID> m_myWalletIds;
     std::set<std::string> m_myAddrLabels;
     beam::wallet::WalletStatus m_status;
+
+    bool m_txRequested = false;
+    bool m_txLoaded = false;
+    // descriptions without the transaction building data, see makeStored()
+    std::map<beam::wallet::TxID, TxPtr> m_transactions;
+
+    // filled on the reactor thread, taken on the UI thread
+    std::mutex m_pendingMutex;
+    bool m_flushScheduled = false;
+    std::map<const char*, std::chrono::steady_clock::time_point> m_pendingSince;
+    boost::optional<beam::wallet::WalletStatus> m_pendingStatus;
+    ChangeCoalescer<beam::wallet::TxDescription, beam::wallet::TxID> m_pendingTransactions;
+    ChangeCoalescer<beam::wallet::Coin, ECC::Hash::Value> m_pendingUtxos;
+    ChangeCoalescer<beam::wallet::ShieldedCoin, ECC::Hash::Value> m_pendingShieldedCoins;
+    ChangeCoalescer<beam::wallet::WalletAddress, beam::wallet::WalletID> m_pendingAddresses;
+    QTimer m_flushTimer;
+    int m_coalescingWindow;
+
+    // functions posted from the reactor thread, run on the UI thread
+    FunctionQueue m_functions;
+
+#if defined(BEAM_UI_PROFILING)
+    std::unique_ptr<CallbackRecorder> m_recorder;
+#endif
 };
@@ -35,10 +35,15 @@
 #include "viewmodel/wallet/token_item.h"
 #include "viewmodel/wallet/assets_view.h"
 #include "viewmodel/wallet/tx_table.h"
+#include "viewmodel/wallet/tx_filter_proxy.h"
 #include "viewmodel/wallet/info_view.h"
 #include "viewmodel/help_view.h"
 #include "viewmodel/settings_view.h"
 #include "viewmodel/messages_view.h"
+#include "viewmodel/event_stats_view.h"
+#if defined(BEAM_UI_PROFILING)
+#include "viewmodel/ui_scenario.h"
+#endif
 #include "viewmodel/statusbar_view.h"
 #include "viewmodel/theme.h"
 #include "viewmodel/receive_view.h"
@@ -48,6 +53,7 @@
 #include "viewmodel/el_seed_validator.h"
 #include "viewmodel/currencies.h"
 #include "model/app_model.h"
+#include "model/stall_watchdog.h"
 #include "viewmodel/qml_globals.h"
 #include "viewmodel/helpers/sortfilterproxymodel.h"
 #include "viewmodel/helpers/token_bootstrap_manager.h"
@@ -106,7 +112,7 @@ int main (int argc, char* argv[])
     QApplication::setAttribute(Qt::AA_ShareOpenGLContexts);
 
     block_sigpipe();
-    QApplication app(argc, argv);
+    WatchedApplication app(argc, argv);
     QDir appDataDir(QStandardPaths::writableLocation(QStandardPaths::DataLocation));
 
     QApplication::setWindowIcon(QIcon(Theme::iconPath()));
@@ -235,6 +241,7 @@ int main (int argc, char* argv[])
             qmlRegisterType<NotificationsViewModel>("Beam.Wallet", 1, 0, "NotificationsViewModel");
             qmlRegisterType<HelpViewModel>("Beam.Wallet", 1, 0, "HelpViewModel");
             qmlRegisterType<MessagesViewModel>("Beam.Wallet", 1, 0, "MessagesViewModel");
+            qmlRegisterType<EventStatsViewModel>("Beam.Wallet", 1, 0, "EventStatsViewModel");
             qmlRegisterType<StatusbarViewModel>("Beam.Wallet", 1, 0, "StatusbarViewModel");
             qmlRegisterType<ReceiveViewModel>("Beam.Wallet", 1, 0, "ReceiveViewModel");
             qmlRegisterType<ReceiveSwapViewModel>("Beam.Wallet", 1, 0, "ReceiveSwapViewModel");
@@ -258,6 +265,7 @@ int main (int argc, char* argv[])
             qmlRegisterType<PushNotificationManager>("Beam.Wallet", 1, 0, "PushNotificationManager");
             qmlRegisterType<ExchangeRatesManager>("Beam.Wallet", 1, 0, "ExchangeRatesManager");
             qmlRegisterType<SortFilterProxyModel>("Beam.Wallet", 1, 0, "SortFilterProxyModel");
+            qmlRegisterType<TxFilterProxyModel>("Beam.Wallet", 1, 0, "TxFilterProxyModel");
             qmlRegisterType<QR>("Beam.Wallet", 1, 0, "QR");
             beamui::applications::RegisterQMLTypes();
 
@@ -280,6 +288,14 @@ int main (int argc, char* argv[])
             window->setFlag(Qt::WindowFullscreenButtonHint);
             window->show();
 
+#if defined(BEAM_UI_PROFILING)
+            std::unique_ptr<UiScenario> scenario;
+            if (settings.runUiScenario())
+            {
+                scenario = std::make_unique<UiScenario>(*window, settings.quitAfterUiScenario());
+            }
+#endif
+
             return QApplication::exec();
         }
         catch (const po::error& e)
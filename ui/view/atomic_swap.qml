@@ -10,6 +10,7 @@ import Beam.Wallet 1.0
 
 Item {
     id: offersViewRoot
+    objectName: "atomicSwapView"
     Layout.fillWidth: true
     Layout.fillHeight: true
 
@@ -0,0 +1,79 @@
+import QtQuick 2.11
+import QtQuick.Controls 2.4
+import QtQuick.Layouts 1.0
+import Beam.Wallet 1.0
+import "."
+
+SettingsFoldable {
+    id: eventStatsBlock
+    property var viewModel
+    //% "Event statistics"
+    title: qsTrId("settings-event-stats-title")
+
+    content: ColumnLayout {
+        spacing: 10
+
+        SFText {
+            Layout.fillWidth: true
+            //% "Delivery latency and handler time, ms"
+            text: qsTrId("settings-event-stats-description")
+            color: Style.content_secondary
+            font.pixelSize: 12
+        }
+
+        GridLayout {
+            Layout.fillWidth: true
+            columns: 5
+            columnSpacing: 15
+            rowSpacing: 4
+
+            Repeater {
+                model: ["", "p50", "p99", "max", "/s"]
+                SFText {
+                    text: modelData
+                    color: Style.content_secondary
+                    font.pixelSize: 12
+                }
+            }
+
+            Repeater {
+                model: viewModel.events
+                delegate: Repeater {
+                    property var event: modelData
+                    model: [
+                        (event.isLatency ? "→ " : "") + event.name,
+                        event.p50,
+                        event.p99,
+                        event.max,
+                        event.rate
+                    ]
+                    SFText {
+                        Layout.fillWidth: index == 0
+                        text: modelData
+                        elide: Text.ElideMiddle
+                        color: Style.content_main
+                        font.pixelSize: 12
+                    }
+                }
+            }
+        }
+
+        SFText {
+            Layout.fillWidth: true
+            text: viewModel.queueStats
+            color: Style.content_secondary
+            font.pixelSize: 12
+            wrapMode: Text.WordWrap
+        }
+
+        CustomButton {
+            Layout.preferredHeight: 38
+            Layout.alignment: Qt.AlignCenter
+            //% "Write to logs"
+            text: qsTrId("settings-event-stats-dump-button")
+            palette.buttonText: "white"
+            palette.button: Style.background_button
+            onClicked: viewModel.dump()
+        }
+    }
+}
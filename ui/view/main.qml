@@ -10,6 +10,7 @@ import "utils.js" as Utils
 
 Rectangle {
     id: main
+    objectName: "main"
 
     property var openedNotifications: 0
     property alias hasNewerVersion : updateInfoProvider.hasNewerVersion
@@ -23,6 +23,7 @@ ColumnLayout {
 
     ReceiveViewModel {
         id: viewModel
+        objectName: "receiveViewModel"
         onNewAddressFailed: {
             var popup = Qt.createComponent("popup_message.qml")
                 .createObject(receiveView)
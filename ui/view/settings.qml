@@ -120,6 +120,16 @@ ColumnLayout {
                     id: reportBlock
                     viewModel: viewModel
                 }
+
+                EventStatsViewModel {
+                    id: eventStatsViewModel
+                }
+
+                SettingsEventStats {
+                    id: eventStatsBlock
+                    viewModel: eventStatsViewModel
+                    visible: eventStatsViewModel.enabled
+                }
             }
 
             ColumnLayout {
@@ -2134,6 +2134,7 @@ Item
 
                                 SFTextInput {
                                     id: openPassword
+                                    objectName: "openWalletPassword"
                                     Layout.fillWidth: true
                                     focus: true
                                     activeFocusOnTab: true
@@ -2185,6 +2186,7 @@ Item
                                 PrimaryButton {
                                     anchors.verticalCenter: parent.verticalCenter
                                     id: btnCurrentWallet
+                                    objectName: "openWalletButton"
                                     enabled: !viewModel.useHWWallet || viewModel.isTrezorConnected
                                     text: (viewModel.useHWWallet == false)
                                         ?
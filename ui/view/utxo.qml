@@ -156,6 +156,7 @@ ColumnLayout {
 
     CustomTableView {
         id: tableView
+        objectName: "utxoTable"
         property int rowHeight: 56
         Layout.fillWidth: true
         Layout.fillHeight: true
@@ -171,6 +171,7 @@ Item {
                 Layout.topMargin:  12
                 Layout.fillWidth:  true
                 Layout.fillHeight: true
+                selectedAsset:     assets.selectedId
             }
         }
     }
@@ -124,6 +124,8 @@ Control {
                         filterString: searchBox.text
                         filterSyntax: SortFilterProxyModel.Wildcard
                         filterCaseSensitivity: Qt.CaseInsensitive
+                        filterDelay: 150
+                        asynchronous: true
                     }
 
                     delegate: RowLayout {
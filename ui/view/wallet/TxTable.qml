@@ -10,35 +10,42 @@ import "../controls"
 Control {
     id: control
 
+    property int selectedAsset: -1
+
     TxTableViewModel {
         id: tableViewModel
     }
 
+    // history is loaded page by page while it is shown newest first, tabs, the asset
+    // and the search select the transactions before paging, other sort orders need all of them
+    function loadAllIfNeeded() {
+        if (transactionsTable.sortIndicatorColumn != 1 || transactionsTable.sortIndicatorOrder != Qt.DescendingOrder) {
+            tableViewModel.loadAllTransactions();
+        }
+    }
+
     state: "all"
     states: [
         State {
             name: "all"
             PropertyChanges { target: allTab; state: "active" }
-            PropertyChanges { target: txProxyModel; filterRole: "status" }
-            PropertyChanges { target: txProxyModel; filterString: "*" }
         },
         State {
             name: "inProgress"
             PropertyChanges { target: inProgressTab; state: "active" }
-            PropertyChanges { target: txProxyModel; filterRole: "isInProgress" }
-            PropertyChanges { target: txProxyModel; filterString: "true" }
+            PropertyChanges { target: txProxyModel; statuses: [TxFilterProxyModel.Pending, TxFilterProxyModel.InProgress, TxFilterProxyModel.Registering] }
         },
         State {
             name: "sent"
             PropertyChanges { target: sentTab; state: "active" }
-            PropertyChanges { target: txProxyModel; filterRole: "isSent" }
-            PropertyChanges { target: txProxyModel; filterString: "true" }
+            PropertyChanges { target: txProxyModel; statuses: [TxFilterProxyModel.Completed] }
+            PropertyChanges { target: txProxyModel; direction: TxFilterProxyModel.Outgoing }
         },
         State {
             name: "received"
             PropertyChanges { target: receivedTab; state: "active" }
-            PropertyChanges { target: txProxyModel; filterRole: "isReceived" }
-            PropertyChanges { target: txProxyModel; filterString: "true" }
+            PropertyChanges { target: txProxyModel; statuses: [TxFilterProxyModel.Completed] }
+            PropertyChanges { target: txProxyModel; direction: TxFilterProxyModel.Incoming }
         }
     ]
 
@@ -114,6 +121,7 @@ Control {
 
             SearchBox {
                id: searchBox
+               objectName: "txSearchBox"
                Layout.preferredWidth: 400
                Layout.alignment: Qt.AlignVCenter
                //% "Transaction or kernel ID, comment, address or contact"
@@ -145,14 +153,18 @@ Control {
 
         CustomTableView {
             id: transactionsTable
+            objectName: "txTable"
             Component.onCompleted: {
+                control.loadAllIfNeeded();
+                if (root.openedTxID != "") {
+                    tableViewModel.loadTransactionsUntil(root.openedTxID);
+                }
                 transactionsTable.model.modelReset.connect(function(){
                     if (root.openedTxID != "") {
                         var index = tableViewModel.transactions.index(0, 0);
                         var indexList = tableViewModel.match(index, TxObjectList.Roles.TxID, root.openedTxID);
                         if (indexList.length > 0) {
-                            index = searchProxyModel.mapFromSource(indexList[0]);
-                            index = txProxyModel.mapFromSource(index);
+                            index = txProxyModel.mapFromSource(indexList[0]);
                             transactionsTable.positionViewAtRow(index.row, ListView.Beginning)
                            // var item = transactionsTable.getItemAt(index.row, ListView.Beginning)
                         }
@@ -178,25 +190,22 @@ Control {
                 sortIndicatorOrder = sortIndicatorColumn != 1
                     ? Qt.AscendingOrder
                     : Qt.DescendingOrder;
+                control.loadAllIfNeeded();
             }
 
-            model: SortFilterProxyModel {
+            onSortIndicatorOrderChanged: control.loadAllIfNeeded()
+
+            model: TxFilterProxyModel {
                 id: txProxyModel
-                source: SortFilterProxyModel {
-                    id: searchProxyModel
-                    source: tableViewModel.transactions
-                    filterRole: "search"
-                    filterString: searchBox.text
-                    filterSyntax: SortFilterProxyModel.Wildcard
-                    filterCaseSensitivity: Qt.CaseInsensitive
-                }
+                source: tableViewModel.transactions
+                assetId: control.selectedAsset
+
+                searchText: searchBox.text
+                filterDelay: 150
 
                 sortOrder: transactionsTable.sortIndicatorOrder
                 sortCaseSensitivity: Qt.CaseInsensitive
                 sortRole: transactionsTable.getColumn(transactionsTable.sortIndicatorColumn).role + "Sort"
-
-                filterSyntax: SortFilterProxyModel.Wildcard
-                filterCaseSensitivity: Qt.CaseInsensitive
             }
 
             rowDelegate: ExpandableRowDelegate {
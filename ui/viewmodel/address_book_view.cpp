@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "address_book_view.h"
+#include "model/event_monitor.h"
 #include "ui_helpers.h"
 #include <QApplication>
 #include <QClipboard>
@@ -159,7 +160,14 @@ AddressBookViewModel::AddressBookViewModel()
             SLOT(onAddressesChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::WalletAddress>&)));
 
     getAddressesFromModel();
-    m_model.getAsync()->getTransactions();
+    if (m_model.isTransactionsLoaded())
+    {
+        applyTransactions(ChangeAction::Reset, m_model.getTransactions());
+    }
+    else
+    {
+        m_model.loadTransactions();
+    }
     startTimer(3 * 1000);
 }
 
@@ -328,6 +336,8 @@ bool AddressBookViewModel::isAddressWithCommentExist(const QString& comment) con
 
 void AddressBookViewModel::onAddresses(bool own, const std::vector<beam::wallet::WalletAddress>& addresses)
 {
+    EventMonitor::Scope monitorScope("AddressBookViewModel::onAddresses");
+
     if (own)
     {
         m_activeAddresses.clear();
@@ -363,11 +373,18 @@ void AddressBookViewModel::onAddresses(bool own, const std::vector<beam::wallet:
 
 void AddressBookViewModel::onAddressesChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::WalletAddress>& addresses)
 {
+    EventMonitor::Scope monitorScope("AddressBookViewModel::onAddressesChanged");
+
     // TODO: refactor this
     getAddressesFromModel();
 }
 
 void AddressBookViewModel::onTransactions(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& transactions)
+{
+    applyTransactions(action, m_model.getTransactions(transactions));
+}
+
+void AddressBookViewModel::applyTransactions(beam::wallet::ChangeAction action, const WalletModel::TxList& transactions)
 {
     switch (action)
     {
@@ -381,9 +398,9 @@ void AddressBookViewModel::onTransactions(beam::wallet::ChangeAction action, con
             {
                 for (const auto& tx : transactions)
                 {
-                    if (!tx.canDelete())    // only active transactions
+                    if (!tx->canDelete())    // only active transactions
                     {
-                        m_busyAddresses.push_back(tx.m_myId);
+                        m_busyAddresses.push_back(tx->m_myId);
                     }
                 }
                 break;
@@ -393,8 +410,8 @@ void AddressBookViewModel::onTransactions(beam::wallet::ChangeAction action, con
             {
                 for (const auto& tx : transactions)
                 {
-                    auto it = find(m_busyAddresses.cbegin(), m_busyAddresses.cend(), tx.m_myId);
-                    if (it != m_busyAddresses.cend() && tx.canDelete())
+                    auto it = find(m_busyAddresses.cbegin(), m_busyAddresses.cend(), tx->m_myId);
+                    if (it != m_busyAddresses.cend() && tx->canDelete())
                     {
                         m_busyAddresses.erase(it);
                     }
@@ -406,7 +423,7 @@ void AddressBookViewModel::onTransactions(beam::wallet::ChangeAction action, con
             {
                 for (const auto& tx : transactions)
                 {
-                    auto it = find(m_busyAddresses.cbegin(), m_busyAddresses.cend(), tx.m_myId);
+                    auto it = find(m_busyAddresses.cbegin(), m_busyAddresses.cend(), tx->m_myId);
                     if (it != m_busyAddresses.cend())
                     {
                         m_busyAddresses.erase(it);
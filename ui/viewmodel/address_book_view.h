@@ -153,6 +153,7 @@ protected:
 private:
 
     void getAddressesFromModel();
+    void applyTransactions(beam::wallet::ChangeAction action, const WalletModel::TxList& transactions);
     void sortActiveAddresses();
     void sortExpiredAddresses();
     void sortContacts();
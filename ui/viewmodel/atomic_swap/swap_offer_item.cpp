@@ -72,6 +72,18 @@ QString SwapOfferItem::rate() const
     return QMLGlobals::divideWithPrecision8(beamui::AmountToUIString(otherCoinAmount), beamui::AmountToUIString(beamAmount));
 }
 
+double SwapOfferItem::rateValue() const
+{
+    beam::Amount otherCoinAmount =
+        isSendBeam() ? rawAmountReceive() : rawAmountSend();
+    beam::Amount beamAmount =
+        isSendBeam() ? rawAmountSend() : rawAmountReceive();
+
+    if (!beamAmount) return 0;
+
+    return static_cast<double>(otherCoinAmount) / static_cast<double>(beamAmount);
+}
+
 QString SwapOfferItem::amountSend() const
 {
     auto coinType = isSendBeam() ? beamui::Currencies::Beam : getSwapCoinType();
@@ -35,6 +35,7 @@ public:
     QString amountSend() const;
     QString amountReceive() const;
     QString rate() const;
+    double rateValue() const;
     bool isOwnOffer() const;
     bool isSendBeam() const;
 
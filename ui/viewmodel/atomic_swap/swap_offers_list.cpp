@@ -15,6 +15,12 @@
 #include "swap_offers_list.h"
 
 SwapOffersList::SwapOffersList()
+    : ListModel([](const auto& offer) { return offer->getTxID(); })
+    , m_sortKeys({ static_cast<int>(Roles::TimeCreatedSort),
+                   static_cast<int>(Roles::AmountSendSort),
+                   static_cast<int>(Roles::AmountReceiveSort),
+                   static_cast<int>(Roles::RateSort),
+                   static_cast<int>(Roles::ExpirationSort) })
 {
 }
 
@@ -104,3 +110,36 @@ QVariant SwapOffersList::data(const QModelIndex &index, int role) const
             return QVariant();
     }
 }
+
+bool SwapOffersList::hasSortKey(int role) const
+{
+    return m_sortKeys.hasRole(role);
+}
+
+bool SwapOffersList::sortKeyLess(int leftRow, int rightRow, int role) const
+{
+    return m_sortKeys.less(m_list[leftRow]->getTxID(), m_list[rightRow]->getTxID(), role);
+}
+
+void SwapOffersList::itemStored(const std::shared_ptr<SwapOfferItem>& item)
+{
+    // rate is compared as a number, its string form doesn't sort
+    m_sortKeys.set(item->getTxID(),
+    {
+        SortKey::fromNumber(static_cast<quint64>(item->timeCreated().toMSecsSinceEpoch())),
+        SortKey::fromNumber(item->rawAmountSend()),
+        SortKey::fromNumber(item->rawAmountReceive()),
+        SortKey::fromDouble(item->rateValue()),
+        SortKey::fromNumber(static_cast<quint64>(item->timeExpiration().toMSecsSinceEpoch()))
+    });
+}
+
+void SwapOffersList::itemErased(const std::shared_ptr<SwapOfferItem>& item)
+{
+    m_sortKeys.remove(item->getTxID());
+}
+
+void SwapOffersList::itemsCleared()
+{
+    m_sortKeys.clear();
+}
@@ -16,8 +16,10 @@
 
 #include "swap_offer_item.h"
 #include "viewmodel/helpers/list_model.h"
+#include "viewmodel/helpers/sort_key.h"
 #include <QLocale>
-class SwapOffersList : public ListModel<std::shared_ptr<SwapOfferItem>>
+class SwapOffersList : public ListModel<std::shared_ptr<SwapOfferItem>, beam::wallet::TxID, RawKeyHash>
+                     , public SortKeyModel
 {
 
     Q_OBJECT
@@ -48,6 +50,15 @@ public:
     QVariant data(const QModelIndex &index, int role) const override;
     QHash<int, QByteArray> roleNames() const override;
 
+    bool hasSortKey(int role) const override;
+    bool sortKeyLess(int leftRow, int rightRow, int role) const override;
+
+protected:
+    void itemStored(const std::shared_ptr<SwapOfferItem>& item) override;
+    void itemErased(const std::shared_ptr<SwapOfferItem>& item) override;
+    void itemsCleared() override;
+
 private:
     QLocale m_locale; // default
+    SortKeyCache<beam::wallet::TxID, RawKeyHash> m_sortKeys;
 };
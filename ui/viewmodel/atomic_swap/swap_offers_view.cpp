@@ -14,6 +14,7 @@
 
 #include <qdebug.h>
 #include "model/app_model.h"
+#include "model/event_monitor.h"
 #include "model/settings.h"
 #include "swap_offers_view.h"
 #include "viewmodel/ui_helpers.h"
@@ -112,10 +113,16 @@ SwapOffersViewModel::SwapOffersViewModel()
 {
     InitSwapClientWrappers();
 
-    connect(&m_walletModel, &WalletModel::walletStatusChanged, this, &SwapOffersViewModel::beamAvailableChanged);
+    connect(&m_walletModel, &WalletModel::assetBalanceChanged, this, [this] (beam::Asset::ID assetId) {
+        if (assetId == beam::Asset::s_BeamID)
+        {
+            emit beamAvailableChanged();
+        }
+    });
     connect(&m_walletModel,
             SIGNAL(transactionsChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>&)),
             SLOT(onTransactionsDataModelChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>&)));
+    connect(&m_walletModel, &WalletModel::heightChanged, &m_transactionsList, &SwapTxObjectList::onHeightChanged);
 
     connect(&m_walletModel,
             SIGNAL(swapOffersChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::SwapOffer>&)),
@@ -124,7 +131,14 @@ SwapOffersViewModel::SwapOffersViewModel()
     monitorAllOffersFitBalance();
 
     m_walletModel.getAsync()->getSwapOffers();
-    m_walletModel.getAsync()->getTransactions();    
+    if (m_walletModel.isTransactionsLoaded())
+    {
+        applyTransactions(ChangeAction::Reset, m_walletModel.getTransactions(WalletModel::TxKind::Swap));
+    }
+    else
+    {
+        m_walletModel.loadTransactions();
+    }
 }
 
 SwapOffersViewModel::~SwapOffersViewModel()
@@ -191,6 +205,12 @@ PaymentInfoItem* SwapOffersViewModel::getPaymentInfo(const QVariant& variantTxID
 }
 
 void SwapOffersViewModel::onTransactionsDataModelChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& transactions)
+{
+    EventMonitor::Scope monitorScope("SwapOffersViewModel::onTransactionsDataModelChanged");
+    applyTransactions(action, m_walletModel.getTransactions(transactions, WalletModel::TxKind::Swap));
+}
+
+void SwapOffersViewModel::applyTransactions(beam::wallet::ChangeAction action, const WalletModel::TxList& transactions)
 {
     vector<shared_ptr<SwapTxObject>> swapTransactions;
     vector<shared_ptr<SwapTxObject>> activeTransactions;
@@ -199,21 +219,18 @@ void SwapOffersViewModel::onTransactionsDataModelChanged(beam::wallet::ChangeAct
 
     for (const auto& t : transactions)
     {
-        if (t.GetParameter<TxType>(TxParameterID::TransactionType) == TxType::AtomicSwap)
+        auto swapCoinType = t->GetParameter<AtomicSwapCoin>(TxParameterID::AtomicSwapCoin);
+        uint32_t minTxConfirmations = swapCoinType ? getTxMinConfirmations(*swapCoinType) : 0;
+        double blocksPerHour = swapCoinType ? getBlocksPerHour(*swapCoinType) : 0;
+        auto newItem = make_shared<SwapTxObject>(*t, minTxConfirmations, blocksPerHour);
+        swapTransactions.push_back(newItem);
+        if (!newItem->isPending() && newItem->isInProgress())
         {
-            auto swapCoinType = t.GetParameter<AtomicSwapCoin>(TxParameterID::AtomicSwapCoin);
-            uint32_t minTxConfirmations = swapCoinType ? getTxMinConfirmations(*swapCoinType) : 0;
-            double blocksPerHour = swapCoinType ? getBlocksPerHour(*swapCoinType) : 0;
-            auto newItem = make_shared<SwapTxObject>(t, minTxConfirmations, blocksPerHour);
-            swapTransactions.push_back(newItem);
-            if (!newItem->isPending() && newItem->isInProgress())
-            {
-                activeTransactions.push_back(newItem);
-            }
-            else
-            {
-                inactiveTransactions.push_back(newItem);
-            }
+            activeTransactions.push_back(newItem);
+        }
+        else
+        {
+            inactiveTransactions.push_back(newItem);
         }
     }
 
@@ -302,6 +319,8 @@ void SwapOffersViewModel::onTransactionsDataModelChanged(beam::wallet::ChangeAct
 
 void SwapOffersViewModel::onSwapOffersDataModelChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::SwapOffer>& offers)
 {
+    EventMonitor::Scope monitorScope("SwapOffersViewModel::onSwapOffersDataModelChanged");
+
     vector<shared_ptr<SwapOfferItem>> modifiedOffers;
     modifiedOffers.reserve(offers.size());
 
@@ -115,6 +115,7 @@ signals:
     void offerRemovedFromTable(QVariant variantTxID);
 
 private:
+    void applyTransactions(beam::wallet::ChangeAction action, const WalletModel::TxList& transactions);
     void monitorAllOffersFitBalance();
     bool isOfferFitBalance(const SwapOfferItem& offer);
     void insertAllOffersFitBalance(
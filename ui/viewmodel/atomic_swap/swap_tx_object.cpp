@@ -111,8 +111,9 @@ namespace
     }
 }  // namespace
 
-SwapTxObject::SwapTxObject(const TxDescription& tx, uint32_t minTxConfirmations, double blocksPerHour, QObject* parent/* = nullptr*/)
-        : TxObject(tx, parent),
+SwapTxObject::SwapTxObject(const TxDescription& tx, uint32_t minTxConfirmations, double blocksPerHour)
+        : TxObject(tx),
+          m_tx(tx),
           m_swapTx(tx),
           m_minTxConfirmations(minTxConfirmations),
           m_blocksPerHour(blocksPerHour)
@@ -124,6 +125,27 @@ bool SwapTxObject::operator==(const SwapTxObject& other) const
     return getTxID() == other.getTxID();
 }
 
+uint32_t SwapTxObject::compare(const SwapTxObject& other) const
+{
+    auto changes = TxObject::compare(other);
+    if (m_swapTx.getState() != other.m_swapTx.getState()
+        || isLockTxProofReceived() != other.isLockTxProofReceived()
+        || isRefundTxProofReceived() != other.isRefundTxProofReceived()
+        || getSwapCoinLockTxId() != other.getSwapCoinLockTxId()
+        || getSwapCoinLockTxConfirmations() != other.getSwapCoinLockTxConfirmations()
+        || getSwapCoinRedeemTxId() != other.getSwapCoinRedeemTxId()
+        || getSwapCoinRedeemTxConfirmations() != other.getSwapCoinRedeemTxConfirmations()
+        || getSwapCoinRefundTxId() != other.getSwapCoinRefundTxId()
+        || getSwapCoinRefundTxConfirmations() != other.getSwapCoinRefundTxConfirmations()
+        || getBeamLockTxKernelId() != other.getBeamLockTxKernelId()
+        || getBeamRedeemTxKernelId() != other.getBeamRedeemTxKernelId()
+        || getBeamRefundTxKernelId() != other.getBeamRefundTxKernelId())
+    {
+        changes |= SwapChanged;
+    }
+    return changes;
+}
+
 auto SwapTxObject::isBeamSideSwap() const -> bool
 {
     return m_swapTx.isBeamSide();
@@ -302,9 +324,9 @@ QString SwapTxObject::getFailureReason() const
 
 QString SwapTxObject::getStateDetails() const
 {
-    if (getTxDescription().m_txType == beam::wallet::TxType::AtomicSwap)
+    if (m_tx.m_txType == beam::wallet::TxType::AtomicSwap)
     {
-        switch (getTxDescription().m_status)
+        switch (m_tx.m_status)
         {
         case beam::wallet::TxStatus::Pending:
         case beam::wallet::TxStatus::InProgress:
@@ -346,6 +368,12 @@ QString SwapTxObject::getStateDetails() const
     return "";
 }
 
+bool SwapTxObject::isHeightDependent() const
+{
+    return m_tx.m_txType == beam::wallet::TxType::AtomicSwap
+        && (m_tx.m_status == beam::wallet::TxStatus::Pending || m_tx.m_status == beam::wallet::TxStatus::InProgress);
+}
+
 beam::wallet::AtomicSwapCoin SwapTxObject::getSwapCoinType() const
 {
     return m_swapTx.getSwapCoin();
@@ -353,7 +381,7 @@ beam::wallet::AtomicSwapCoin SwapTxObject::getSwapCoinType() const
 
 auto SwapTxObject::getStatus() const -> QString
 {
-    SwapTxStatusInterpreter interpreter(getTxDescription());
+    SwapTxStatusInterpreter interpreter(m_tx);
     return interpreter.getStatus().c_str();
 }
 
@@ -19,11 +19,10 @@
 class SwapTxObject : public TxObject
 {
     // TODO: consider remove inheritance of TxObject
-    Q_OBJECT
-
 public:
-    SwapTxObject(const beam::wallet::TxDescription& tx, uint32_t minTxConfirmations, double blocksPerHour, QObject* parent = nullptr);
+    SwapTxObject(const beam::wallet::TxDescription& tx, uint32_t minTxConfirmations, double blocksPerHour);
     bool operator==(const SwapTxObject& other) const;
+    uint32_t compare(const SwapTxObject& other) const;
 
     auto getSentAmountWithCurrency() const -> QString;
     auto getSentAmount() const-> QString;
@@ -47,8 +46,9 @@ public:
     auto getFee() const -> QString override;
     auto getFailureReason() const -> QString override;
     QString getStateDetails() const override;
+    bool isHeightDependent() const override;
     beam::wallet::AtomicSwapCoin getSwapCoinType() const;
-    auto getStatus() const -> QString override;
+    auto getStatus() const -> QString;
     QString getAmountWithCurrency() const;
 
     bool isLockTxProofReceived() const;
@@ -64,12 +64,12 @@ public:
     bool isCanceled() const override;
     bool isFailed() const override;
 
-signals:
-
 private:
     auto getSwapAmountValue(bool sent) const -> beam::Amount;
     auto getSwapAmountWithCurrency(bool sent) const -> QString;
 
+    // swap rows are few and their roles read many parameters, so the full description is kept
+    beam::wallet::TxDescription m_tx;
     beam::wallet::SwapTxDescription m_swapTx;
     uint32_t m_minTxConfirmations = 0;
     double m_blocksPerHour = 0;
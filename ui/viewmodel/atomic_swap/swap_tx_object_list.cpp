@@ -14,9 +14,39 @@
 
 #include "swap_tx_object_list.h"
 #include "viewmodel/ui_helpers.h"
+#include "model/app_model.h"
 
 SwapTxObjectList::SwapTxObjectList()
+    : ListModel([](const auto& tx) { return tx->getTxID(); })
+    // StateDetails depends on the current height and is not kept
+    , m_displayValues({ static_cast<int>(Roles::TimeCreated),
+                        static_cast<int>(Roles::AmountGeneralWithCurrency),
+                        static_cast<int>(Roles::AmountGeneral),
+                        static_cast<int>(Roles::Status),
+                        static_cast<int>(Roles::StatusSort),
+                        static_cast<int>(Roles::Fee),
+                        static_cast<int>(Roles::TxID),
+                        static_cast<int>(Roles::FailureReason),
+                        static_cast<int>(Roles::Search),
+                        static_cast<int>(Roles::AmountSendWithCurrency),
+                        static_cast<int>(Roles::AmountSend),
+                        static_cast<int>(Roles::AmountReceiveWithCurrency),
+                        static_cast<int>(Roles::AmountReceive),
+                        static_cast<int>(Roles::Token),
+                        static_cast<int>(Roles::SwapCoin),
+                        static_cast<int>(Roles::SwapCoinFeeRate),
+                        static_cast<int>(Roles::SwapCoinFee),
+                        static_cast<int>(Roles::SwapCoinLockTxId),
+                        static_cast<int>(Roles::SwapCoinLockTxConfirmations),
+                        static_cast<int>(Roles::SwapCoinRedeemTxId),
+                        static_cast<int>(Roles::SwapCoinRedeemTxConfirmations),
+                        static_cast<int>(Roles::SwapCoinRefundTxId),
+                        static_cast<int>(Roles::SwapCoinRefundTxConfirmations),
+                        static_cast<int>(Roles::BeamLockTxKernelId),
+                        static_cast<int>(Roles::BeamRedeemTxKernelId),
+                        static_cast<int>(Roles::BeamRefundTxKernelId) })
 {
+    connect(&AppModel::getInstance().getSettings(), &WalletSettings::localeChanged, this, &SwapTxObjectList::onLocaleChanged);
 }
 
 auto SwapTxObjectList::roleNames() const -> QHash<int, QByteArray>
@@ -91,6 +121,15 @@ auto SwapTxObjectList::data(const QModelIndex &index, int role) const -> QVarian
     }
     
     auto& value = m_list[index.row()];
+    if (m_displayValues.hasRole(role))
+    {
+        return m_displayValues.get(value->getTxID(), role, [&] () { return roleValue(value, role); });
+    }
+    return roleValue(value, role);
+}
+
+QVariant SwapTxObjectList::roleValue(const std::shared_ptr<SwapTxObject>& value, int role) const
+{
     switch (static_cast<Roles>(role))
     {
         case Roles::TimeCreated:
@@ -261,3 +300,108 @@ auto SwapTxObjectList::data(const QModelIndex &index, int role) const -> QVarian
             return QVariant();
     }
 }
+
+QVector<int> SwapTxObjectList::changedRoles(const std::shared_ptr<SwapTxObject>& prev, const std::shared_ptr<SwapTxObject>& next) const
+{
+    QVector<int> roles;
+    auto add = [&roles](std::initializer_list<Roles> changed)
+    {
+        for (auto role : changed)
+        {
+            if (!roles.contains(static_cast<int>(role)))
+            {
+                roles.push_back(static_cast<int>(role));
+            }
+        }
+    };
+
+    const auto changes = prev->compare(*next);
+    if (changes & (TxObject::StatusChanged | TxObject::SwapChanged))
+    {
+        // swap status and flags are derived from both the tx status and the swap state
+        add({ Roles::Status, Roles::StatusSort, Roles::StateDetails, Roles::FailureReason,
+              Roles::IsCancelAvailable, Roles::IsDeleteAvailable, Roles::IsInProgress, Roles::IsPending,
+              Roles::IsCompleted, Roles::IsCanceled, Roles::IsFailed, Roles::IsExpired, Roles::HasPaymentProof });
+    }
+    if (changes & TxObject::SwapChanged)
+    {
+        add({ Roles::IsLockTxProofReceived, Roles::IsRefundTxProofReceived,
+              Roles::SwapCoinLockTxId, Roles::SwapCoinLockTxConfirmations,
+              Roles::SwapCoinRedeemTxId, Roles::SwapCoinRedeemTxConfirmations,
+              Roles::SwapCoinRefundTxId, Roles::SwapCoinRefundTxConfirmations,
+              Roles::BeamLockTxKernelId, Roles::BeamRedeemTxKernelId, Roles::BeamRefundTxKernelId });
+    }
+    if (changes & TxObject::KernelChanged)
+    {
+        add({ Roles::KernelID, Roles::Search });
+    }
+    if (changes & TxObject::FailureChanged)
+    {
+        add({ Roles::FailureReason, Roles::IsExpired, Roles::IsFailed });
+    }
+    if (changes & (TxObject::FeeChanged | TxObject::SwapChanged))
+    {
+        add({ Roles::Fee, Roles::SwapCoinFee, Roles::SwapCoinFeeRate });
+    }
+    if (changes & TxObject::AddressChanged)
+    {
+        add({ Roles::AddressFrom, Roles::AddressFromSort, Roles::AddressTo, Roles::AddressToSort,
+              Roles::Token, Roles::Search });
+    }
+    if (changes & TxObject::StateChanged)
+    {
+        add({ Roles::StateDetails });
+    }
+    if (changes & TxObject::AmountChanged)
+    {
+        add({ Roles::AmountGeneralWithCurrency, Roles::AmountGeneralWithCurrencySort,
+              Roles::AmountGeneral, Roles::AmountGeneralSort });
+    }
+    if (changes & TxObject::CommentChanged)
+    {
+        add({ Roles::Comment, Roles::Search });
+    }
+    return roles;
+}
+
+void SwapTxObjectList::itemStored(const std::shared_ptr<SwapTxObject>& item)
+{
+    m_displayValues.remove(item->getTxID());
+    if (item->isHeightDependent())
+    {
+        m_heightDependent.insert(item->getTxID());
+    }
+    else
+    {
+        m_heightDependent.erase(item->getTxID());
+    }
+}
+
+void SwapTxObjectList::itemErased(const std::shared_ptr<SwapTxObject>& item)
+{
+    m_displayValues.remove(item->getTxID());
+    m_heightDependent.erase(item->getTxID());
+}
+
+void SwapTxObjectList::itemsCleared()
+{
+    m_displayValues.clear();
+    m_heightDependent.clear();
+}
+
+void SwapTxObjectList::onHeightChanged()
+{
+    touchRows(m_heightDependent, { static_cast<int>(Roles::StateDetails) });
+}
+
+void SwapTxObjectList::onLocaleChanged()
+{
+    m_locale = QLocale();
+    m_displayValues.invalidate(static_cast<int>(Roles::TimeCreated));
+    m_displayValues.invalidate(static_cast<int>(Roles::FailureReason));
+    if (!m_list.isEmpty())
+    {
+        emit dataChanged(index(0), index(m_list.size() - 1),
+                         { static_cast<int>(Roles::TimeCreated), static_cast<int>(Roles::FailureReason) });
+    }
+}
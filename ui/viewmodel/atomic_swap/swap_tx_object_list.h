@@ -16,9 +16,11 @@
 
 #include "swap_tx_object.h"
 #include "viewmodel/helpers/list_model.h"
+#include "viewmodel/helpers/role_cache.h"
 #include <QLocale>
+#include <unordered_set>
 
-class SwapTxObjectList : public ListModel<std::shared_ptr<SwapTxObject>>
+class SwapTxObjectList : public ListModel<std::shared_ptr<SwapTxObject>, beam::wallet::TxID, RawKeyHash>
 {
 
     Q_OBJECT
@@ -91,6 +93,23 @@ public:
     QVariant data(const QModelIndex &index, int role) const override;
     QHash<int, QByteArray> roleNames() const override;
 
+public slots:
+    // only the swaps counting down to a height are refreshed
+    void onHeightChanged();
+
+protected:
+    QVector<int> changedRoles(const std::shared_ptr<SwapTxObject>& prev, const std::shared_ptr<SwapTxObject>& next) const override;
+    void itemStored(const std::shared_ptr<SwapTxObject>& item) override;
+    void itemErased(const std::shared_ptr<SwapTxObject>& item) override;
+    void itemsCleared() override;
+
+private slots:
+    void onLocaleChanged();
+
 private:
+    QVariant roleValue(const std::shared_ptr<SwapTxObject>& value, int role) const;
+
     QLocale m_locale; // default locale
+    mutable RoleValueCache<beam::wallet::TxID, RawKeyHash> m_displayValues;
+    std::unordered_set<beam::wallet::TxID, RawKeyHash> m_heightDependent;
 };
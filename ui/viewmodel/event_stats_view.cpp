@@ -0,0 +1,81 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "event_stats_view.h"
+#include "model/app_model.h"
+
+namespace
+{
+    const int kRefreshIntervalMs = 1000;
+
+    QString toMilliseconds(int64_t micros)
+    {
+        return QString::number(micros / 1000.0, 'f', 2);
+    }
+}
+
+EventStatsViewModel::EventStatsViewModel()
+    : m_enabled(AppModel::getInstance().getSettings().showEventStats())
+{
+    if (m_enabled)
+    {
+        connect(&m_refreshTimer, &QTimer::timeout, this, &EventStatsViewModel::statsChanged);
+        m_refreshTimer.start(kRefreshIntervalMs);
+    }
+}
+
+bool EventStatsViewModel::isEnabled() const
+{
+    return m_enabled;
+}
+
+QVariantList EventStatsViewModel::getEvents() const
+{
+    QVariantList events;
+    for (const auto& summary : AppModel::getInstance().getEventMonitor().getSummaries())
+    {
+        QVariantMap event;
+        event["name"] = QString::fromStdString(summary.name);
+        event["isLatency"] = summary.kind == EventMonitor::Kind::Latency;
+        event["count"] = static_cast<qulonglong>(summary.count);
+        event["rate"] = QString::number(summary.rate, 'f', 1);
+        event["p50"] = toMilliseconds(summary.p50);
+        event["p99"] = toMilliseconds(summary.p99);
+        event["max"] = toMilliseconds(summary.max);
+        events.push_back(event);
+    }
+    return events;
+}
+
+QString EventStatsViewModel::getQueueStats() const
+{
+    auto wallet = AppModel::getInstance().getWallet();
+    if (!wallet)
+    {
+        return QString();
+    }
+
+    const auto stats = wallet->getPostedFunctionStats();
+    return QString("posted %1, depth %2, drains %3, max batch %4, last drain %5 ms")
+        .arg(stats.pushed)
+        .arg(stats.depth)
+        .arg(stats.drains)
+        .arg(stats.maxBatch)
+        .arg(toMilliseconds(stats.lastDrainMicroseconds));
+}
+
+void EventStatsViewModel::dump()
+{
+    AppModel::getInstance().getEventMonitor().dump();
+}
@@ -0,0 +1,44 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <QVariantList>
+
+// Debug panel over EventMonitor, enabled by debug/show_event_stats in settings.ini
+class EventStatsViewModel : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool         enabled    READ isEnabled     CONSTANT)
+    Q_PROPERTY(QVariantList events     READ getEvents     NOTIFY statsChanged)
+    Q_PROPERTY(QString      queueStats READ getQueueStats NOTIFY statsChanged)
+
+public:
+    EventStatsViewModel();
+
+    bool isEnabled() const;
+    QVariantList getEvents() const;
+    QString getQueueStats() const;
+
+    Q_INVOKABLE void dump();
+
+signals:
+    void statsChanged();
+
+private:
+    bool m_enabled;
+    QTimer m_refreshTimer;
+};
@@ -14,11 +14,29 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
+#include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include <QAbstractListModel>
+#include <QHash>
+#include <QVector>
 Q_DECLARE_METATYPE(QModelIndex)
-template <typename T>
+
+// Hashes fixed-size ids (TxID, ECC::uintBig) by their raw bytes
+struct RawKeyHash
+{
+    template<typename Y>
+    size_t operator()(const Y& key) const
+    {
+        return qHashBits(&key, sizeof(Y));
+    }
+};
+
+template <typename T, typename Key = int, typename KeyHash = std::hash<Key>>
 class ListModel : public QAbstractListModel
 {
     template<typename Y>
@@ -37,11 +55,21 @@ class ListModel : public QAbstractListModel
         constexpr bool operator()(const std::shared_ptr<Y>& other) { return *value == *other; }
     };
 public:
+    using KeyExtractor = std::function<Key(const T&)>;
+
     ListModel(QObject* pObj = nullptr)
         : QAbstractListModel(pObj)
     {
     }
 
+    // With a key extractor rows are tracked in a hash index,
+    // so update/remove find their rows in O(1) instead of scanning the list
+    explicit ListModel(KeyExtractor keyExtractor, QObject* pObj = nullptr)
+        : QAbstractListModel(pObj)
+        , m_keyExtractor(std::move(keyExtractor))
+    {
+    }
+
     int rowCount(const QModelIndex &parent = QModelIndex()) const
     {
         if (parent.isValid())
@@ -54,8 +82,10 @@ public:
     void insert(const T& item)
     {
         int row = m_list.size();
-        beginInsertRows(QModelIndex(), row,row + 1);
+        beginInsertRows(QModelIndex(), row, row);
         m_list.push_back(item);
+        itemStored(item);
+        reindex(row);
         endInsertRows();
     }
 
@@ -70,20 +100,68 @@ public:
         for (const auto& item : items)
         {
             m_list.push_back(item);
+            itemStored(item);
         }
+        reindex(row);
         endInsertRows();
     }
 
+    // Keyed models are brought to the new item set with minimal remove/update/insert signals,
+    // rows which survive the reset stay in place so views keep selection and scroll position
     void reset(const std::vector<T>& items)
     {
-        int row = 0;
-        beginResetModel();
-        m_list.clear();
-        for (const auto& item : items)
+        if (!m_keyExtractor || m_list.isEmpty())
+        {
+            rebuild(items);
+            return;
+        }
+
+        std::unordered_map<Key, size_t, KeyHash> incoming;
+        incoming.reserve(items.size());
+        for (size_t i = 0; i < items.size(); ++i)
         {
-            m_list.insert(row, item);
+            incoming[m_keyExtractor(items[i])] = i;
         }
-        endResetModel();
+
+        std::vector<int> stale;
+        for (int row = 0; row < m_list.size(); ++row)
+        {
+            if (incoming.find(m_keyExtractor(m_list[row])) == incoming.end())
+            {
+                stale.push_back(row);
+            }
+        }
+
+        if (stale.size() == size_t(m_list.size()))
+        {
+            // nothing to preserve, e.g. another wallet has been opened
+            rebuild(items);
+            return;
+        }
+
+        eraseRows(stale);
+
+        std::vector<T> kept;
+        std::vector<T> added;
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            const auto key = m_keyExtractor(items[i]);
+            if (incoming[key] != i)
+            {
+                continue; // duplicate, the latest one is taken
+            }
+            if (rowOf(key) >= 0)
+            {
+                kept.push_back(items[i]);
+            }
+            else
+            {
+                added.push_back(items[i]);
+            }
+        }
+
+        update(kept);
+        insert(added);
     }
 
     T get(int index) const
@@ -93,42 +171,73 @@ public:
 
     void remove(const std::vector<T>& items)
     {
+        std::vector<int> rows;
+        rows.reserve(items.size());
         for (const auto& item : items)
         {
-            auto it = std::find_if(std::begin(m_list), std::end(m_list), Comparator<T>(item));
-
-            if (it != std::end(m_list))
+            auto row = findRow(item);
+            if (row >= 0)
             {
-                auto index = m_list.indexOf(*it);
-                beginRemoveRows(QModelIndex(), index, index);
-                m_list.removeAt(index);
-                endRemoveRows();
+                rows.push_back(row);
             }
         }
+        eraseRows(rows);
     }
 
     void update(const std::vector<T>& items)
     {
+        // rows are ordered to report contiguous ranges with a single signal,
+        // the latest item wins if the batch has duplicates
+        std::map<int, T> found;
+        std::vector<T> missing;
         for (const auto& item : items)
         {
-            auto it = std::find_if(std::begin(m_list), std::end(m_list), Comparator<T>(item));
+            auto row = findRow(item);
+            if (row >= 0)
+            {
+                found[row] = item;
+            }
+            else
+            {
+                missing.push_back(item);
+            }
+        }
 
-            // index to add item on last position by default
-            int index = (m_list.count() == 0) ? 0 : m_list.count() - 1;
+        // rows are replaced in place, delegates and proxies see only the roles which really changed
+        int first = -1;
+        int last = -1;
+        QVector<int> rangeRoles;
+        for (const auto& p : found)
+        {
+            auto roles = changedRoles(m_list[p.first], p.second);
+            m_list[p.first] = p.second;
+            itemStored(p.second);
+            if (roles.isEmpty())
+            {
+                continue;
+            }
 
-            if (it != std::end(m_list))
+            if (first >= 0 && (p.first != last + 1 || roles != rangeRoles))
             {
-                index = m_list.indexOf(*it);
+                emit dataChanged(createIndex(first, 0), createIndex(last, 0), rangeRoles);
+                first = -1;
+            }
 
-                beginRemoveRows(QModelIndex(), index, index);
-                m_list.removeAt(index);
-                endRemoveRows();
+            if (first < 0)
+            {
+                first = p.first;
+                rangeRoles = std::move(roles);
             }
+            last = p.first;
+        }
 
-            beginInsertRows(QModelIndex(), index, index);
-            m_list.insert(index, item);
-            endInsertRows();
+        if (first >= 0)
+        {
+            emit dataChanged(createIndex(first, 0), createIndex(last, 0), rangeRoles);
         }
+
+        // updated rows keep their keys and positions, so the index stays valid
+        insert(missing);
     }
 
     auto begin()
@@ -154,5 +263,144 @@ public:
     }
 
 protected:
+    // Roles which differ between the stored row and its replacement,
+    // an empty result means the row is unchanged and no signal is emitted
+    virtual QVector<int> changedRoles(const T& prev, const T& next) const
+    {
+        Q_UNUSED(prev);
+        Q_UNUSED(next);
+        return roleNames().keys().toVector();
+    }
+
+    // Notifications for subclasses which keep derived per-item data in sync with the list,
+    // itemStored is called for new items and for replacements of existing ones
+    virtual void itemStored(const T& item)
+    {
+        Q_UNUSED(item);
+    }
+
+    virtual void itemErased(const T& item)
+    {
+        Q_UNUSED(item);
+    }
+
+    virtual void itemsCleared()
+    {
+    }
+
+    // dataChanged for some roles of the keyed rows, contiguous rows share a signal
+    template <typename Keys>
+    void touchRows(const Keys& keys, const QVector<int>& roles)
+    {
+        std::vector<int> rows;
+        rows.reserve(keys.size());
+        for (const auto& key : keys)
+        {
+            if (auto row = rowOf(key); row >= 0)
+            {
+                rows.push_back(row);
+            }
+        }
+        std::sort(rows.begin(), rows.end());
+
+        for (size_t i = 0; i < rows.size();)
+        {
+            const int first = rows[i];
+            int last = first;
+            while (++i < rows.size() && rows[i] == last + 1)
+            {
+                last = rows[i];
+            }
+            emit dataChanged(createIndex(first, 0), createIndex(last, 0), roles);
+        }
+    }
+
+    int rowOf(const Key& key) const
+    {
+        const auto it = m_index.find(key);
+        return it != m_index.end() ? it->second : -1;
+    }
+
+    int findRow(const T& item) const
+    {
+        if (m_keyExtractor)
+        {
+            return rowOf(m_keyExtractor(item));
+        }
+
+        auto it = std::find_if(std::begin(m_list), std::end(m_list), Comparator<T>(item));
+        return it != std::end(m_list) ? int(it - std::begin(m_list)) : -1;
+    }
+
+    void eraseRows(std::vector<int> rows)
+    {
+        if (rows.empty())
+        {
+            return;
+        }
+
+        std::sort(rows.begin(), rows.end(), std::greater<int>());
+        rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+        for (auto row : rows)
+        {
+            if (m_keyExtractor)
+            {
+                m_index.erase(m_keyExtractor(m_list[row]));
+            }
+            itemErased(m_list[row]);
+        }
+
+        // going from the bottom keeps the remaining row numbers valid
+        for (size_t i = 0; i < rows.size();)
+        {
+            const int last = rows[i];
+            int first = last;
+            while (++i < rows.size() && rows[i] == first - 1)
+            {
+                first = rows[i];
+            }
+
+            beginRemoveRows(QModelIndex(), first, last);
+            m_list.erase(m_list.begin() + first, m_list.begin() + last + 1);
+            endRemoveRows();
+        }
+
+        reindex(rows.back());
+    }
+
+    void rebuild(const std::vector<T>& items)
+    {
+        beginResetModel();
+        m_list.clear();
+        itemsCleared();
+        m_list.reserve(int(items.size()));
+        for (const auto& item : items)
+        {
+            m_list.push_back(item);
+            itemStored(item);
+        }
+        m_index.clear();
+        reindex(0);
+        endResetModel();
+    }
+
+    void reindex(int fromRow)
+    {
+        if (!m_keyExtractor)
+        {
+            return;
+        }
+
+        for (int row = fromRow; row < m_list.size(); ++row)
+        {
+            m_index[m_keyExtractor(m_list[row])] = row;
+        }
+    }
+
     QList<T> m_list;
+
+private:
+    KeyExtractor m_keyExtractor;
+    std::unordered_map<Key, int, KeyHash> m_index;
 };
@@ -0,0 +1,124 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <unordered_map>
+
+#include <QVariant>
+#include <QVector>
+
+// Display values of items for a fixed set of roles. A value is computed on the first
+// data() call which asks for it and kept until the item is replaced or the role is invalidated.
+// Only the values of the most recently asked items are kept, the view asks for the visible rows
+// over and over while the rest of a long list may never be shown again
+template <typename Key, typename KeyHash = std::hash<Key>>
+class RoleValueCache
+{
+public:
+    // a few screens of rows in the largest window
+    static constexpr size_t kDefaultCapacity = 1024;
+
+    explicit RoleValueCache(QVector<int> roles, size_t capacity = kDefaultCapacity)
+        : m_roles(std::move(roles))
+        , m_capacity(std::max<size_t>(capacity, 1))
+    {
+    }
+
+    bool hasRole(int role) const
+    {
+        return m_roles.contains(role);
+    }
+
+    template <typename Compute>
+    QVariant get(const Key& key, int role, Compute&& compute)
+    {
+        auto it = m_values.find(key);
+        if (it == m_values.end())
+        {
+            if (m_values.size() >= m_capacity)
+            {
+                m_values.erase(m_recent.back());
+                m_recent.pop_back();
+            }
+            m_recent.push_front(key);
+            it = m_values.emplace(key, Entry{ QVector<QVariant>(m_roles.size()), m_recent.begin() }).first;
+        }
+        else if (it->second.recent != m_recent.begin())
+        {
+            m_recent.splice(m_recent.begin(), m_recent, it->second.recent);
+        }
+        auto& value = it->second.values[m_roles.indexOf(role)];
+        if (!value.isValid())
+        {
+            value = compute();
+        }
+        return value;
+    }
+
+    // the item has been replaced or erased
+    void remove(const Key& key)
+    {
+        if (const auto it = m_values.find(key); it != m_values.end())
+        {
+            m_recent.erase(it->second.recent);
+            m_values.erase(it);
+        }
+    }
+
+    // values of the role depend on something outside of the items
+    void invalidate(int role)
+    {
+        const int slot = m_roles.indexOf(role);
+        if (slot < 0)
+        {
+            return;
+        }
+        for (auto& item : m_values)
+        {
+            item.second.values[slot] = QVariant();
+        }
+    }
+
+    // the value of the item for the role depends on something outside of the item
+    void invalidate(const Key& key, int role)
+    {
+        const int slot = m_roles.indexOf(role);
+        if (const auto it = m_values.find(key); slot >= 0 && it != m_values.end())
+        {
+            it->second.values[slot] = QVariant();
+        }
+    }
+
+    void clear()
+    {
+        m_values.clear();
+        m_recent.clear();
+    }
+
+private:
+    struct Entry
+    {
+        QVector<QVariant> values;
+        typename std::list<Key>::iterator recent;
+    };
+
+    QVector<int> m_roles;
+    const size_t m_capacity;
+    std::list<Key> m_recent;    // the most recently asked first
+    std::unordered_map<Key, Entry, KeyHash> m_values;
+};
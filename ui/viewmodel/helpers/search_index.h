@@ -0,0 +1,179 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <QString>
+#include <QStringMatcher>
+
+// Implemented by list models which answer case insensitive substring queries
+// on one of their roles from their own index, SortFilterProxyModel uses it instead of data().
+// The query is case folded by the caller, once per filter change
+class SearchableModel
+{
+public:
+    virtual ~SearchableModel() = default;
+    virtual bool isSearchRole(int role) const = 0;
+    virtual bool searchMatches(int row, const QString& foldedQuery) const = 0;
+};
+
+// Case insensitive substring index over a text per item.
+// Only a 64 byte trigram signature is kept per item, so most non-matching items are
+// rejected by a few bit operations; the text of the items which pass is read back
+// from the model to confirm the match. Results of the last query are cached and
+// a query which contains the previous one only rechecks the items that matched it
+template <typename Key, typename KeyHash = std::hash<Key>>
+class SearchIndex
+{
+public:
+    // the current text of an item, as given to set()
+    using TextSource = std::function<QString(const Key&)>;
+
+    explicit SearchIndex(TextSource textOf)
+        : m_textOf(std::move(textOf))
+    {
+    }
+
+    void set(const Key& key, const QString& text)
+    {
+        const auto folded = text.toCaseFolded();
+        auto& signature = m_entries[key];
+        signature = signatureOf(folded);
+
+        if (m_queryValid)
+        {
+            if (covers(signature, m_querySignature) && m_matcher.indexIn(folded) >= 0)
+            {
+                m_matches.insert(key);
+            }
+            else
+            {
+                m_matches.erase(key);
+            }
+        }
+    }
+
+    void remove(const Key& key)
+    {
+        m_entries.erase(key);
+        m_matches.erase(key);
+    }
+
+    void clear()
+    {
+        m_entries.clear();
+        m_matches.clear();
+        m_queryValid = false;
+    }
+
+    bool contains(const Key& key, const QString& foldedQuery) const
+    {
+        prepare(foldedQuery);
+        return m_matches.find(key) != m_matches.end();
+    }
+
+    // keys of all the items which match, valid until the next query or change
+    const std::unordered_set<Key, KeyHash>& matching(const QString& foldedQuery) const
+    {
+        prepare(foldedQuery);
+        return m_matches;
+    }
+
+private:
+    using Signature = std::array<uint64_t, 8>;
+
+    static Signature signatureOf(const QString& text)
+    {
+        Signature signature = {};
+        for (int i = 0; i + 2 < text.size(); ++i)
+        {
+            const uint32_t gram = text[i].unicode() * 31u * 31u + text[i + 1].unicode() * 31u + text[i + 2].unicode();
+            const uint32_t bit = (gram * 2654435761u) >> 23; // 9 bits, 512 buckets
+            signature[bit >> 6] |= uint64_t(1) << (bit & 63);
+        }
+        return signature;
+    }
+
+    static bool covers(const Signature& signature, const Signature& querySignature)
+    {
+        for (size_t i = 0; i < querySignature.size(); ++i)
+        {
+            if ((signature[i] & querySignature[i]) != querySignature[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool matches(const Key& key, const Signature& signature) const
+    {
+        return covers(signature, m_querySignature) && m_matcher.indexIn(m_textOf(key).toCaseFolded()) >= 0;
+    }
+
+    void prepare(const QString& query) const
+    {
+        if (m_queryValid && query == m_query)
+        {
+            return;
+        }
+
+        const bool refine = m_queryValid && !m_query.isEmpty() && query.contains(m_query);
+        m_query = query;
+        m_matcher = QStringMatcher(query, Qt::CaseSensitive);
+        m_querySignature = signatureOf(query);
+        m_queryValid = true;
+
+        if (refine)
+        {
+            for (auto it = m_matches.begin(); it != m_matches.end();)
+            {
+                const auto entry = m_entries.find(*it);
+                if (entry == m_entries.end() || !matches(entry->first, entry->second))
+                {
+                    it = m_matches.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            return;
+        }
+
+        m_matches.clear();
+        for (const auto& p : m_entries)
+        {
+            if (matches(p.first, p.second))
+            {
+                m_matches.insert(p.first);
+            }
+        }
+    }
+
+    TextSource m_textOf;
+    std::unordered_map<Key, Signature, KeyHash> m_entries;
+
+    mutable bool m_queryValid = false;
+    mutable QString m_query;
+    mutable QStringMatcher m_matcher;
+    mutable Signature m_querySignature = {};
+    mutable std::unordered_set<Key, KeyHash> m_matches;
+};
@@ -0,0 +1,127 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstring>
+#include <functional>
+#include <unordered_map>
+
+#include <QString>
+#include <QVector>
+
+// Sort position of a row for one role: the number is compared first, then the case-folded text
+struct SortKey
+{
+    quint64 number = 0;
+    QString text;
+
+    static SortKey fromNumber(quint64 number)
+    {
+        SortKey key;
+        key.number = number;
+        return key;
+    }
+
+    // non-negative doubles keep their order when compared by their bits
+    static SortKey fromDouble(double value)
+    {
+        SortKey key;
+        if (value > 0)
+        {
+            static_assert(sizeof(double) == sizeof(quint64), "unexpected double size");
+            std::memcpy(&key.number, &value, sizeof(value));
+        }
+        return key;
+    }
+
+    static SortKey fromText(const QString& text)
+    {
+        SortKey key;
+        key.text = text.toCaseFolded();
+        return key;
+    }
+
+    bool operator<(const SortKey& other) const
+    {
+        if (number != other.number)
+        {
+            return number < other.number;
+        }
+        return text < other.text;
+    }
+};
+
+// Implemented by list models which keep sort keys of their rows,
+// SortFilterProxyModel compares them instead of QVariants fetched through data()
+class SortKeyModel
+{
+public:
+    virtual ~SortKeyModel() = default;
+    virtual bool hasSortKey(int role) const = 0;
+    virtual bool sortKeyLess(int leftRow, int rightRow, int role) const = 0;
+};
+
+// Sort keys of items for a fixed set of roles, computed once when an item is stored
+template <typename Key, typename KeyHash = std::hash<Key>>
+class SortKeyCache
+{
+public:
+    explicit SortKeyCache(QVector<int> roles)
+        : m_roles(std::move(roles))
+    {
+    }
+
+    bool hasRole(int role) const
+    {
+        return m_roles.contains(role);
+    }
+
+    const QVector<int>& roles() const
+    {
+        return m_roles;
+    }
+
+    // keys must follow the order of roles()
+    void set(const Key& key, QVector<SortKey> keys)
+    {
+        m_keys[key] = std::move(keys);
+    }
+
+    void remove(const Key& key)
+    {
+        m_keys.erase(key);
+    }
+
+    void clear()
+    {
+        m_keys.clear();
+    }
+
+    bool less(const Key& left, const Key& right, int role) const
+    {
+        const int slot = m_roles.indexOf(role);
+        const auto l = m_keys.find(left);
+        const auto r = m_keys.find(right);
+        if (slot < 0 || l == m_keys.end() || r == m_keys.end())
+        {
+            return false;
+        }
+        return l->second[slot] < r->second[slot];
+    }
+
+private:
+    QVector<int> m_roles;
+    std::unordered_map<Key, QVector<SortKey>, KeyHash> m_keys;
+};
@@ -13,17 +13,93 @@
 // limitations under the License.
 
 #include "sortfilterproxymodel.h"
+#include "search_index.h"
+#include "sort_key.h"
+#include "model/event_monitor.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace
+{
+    class FunctionRunnable : public QRunnable
+    {
+    public:
+        explicit FunctionRunnable(std::function<void()> func)
+            : m_func(std::move(func))
+        {
+        }
+
+        void run() override
+        {
+            m_func();
+        }
+
+    private:
+        std::function<void()> m_func;
+    };
+
+    const QString kRegExpSpecialChars = QStringLiteral("\\^$.|?*+()[]{}");
+
+    bool hasAnyOf(const QString &str, const QString &chars)
+    {
+        for (const auto &c : str) {
+            if (chars.contains(c))
+                return true;
+        }
+        return false;
+    }
+
+    // QRegExp wildcards are matched anywhere in the string, so the result is not anchored
+    QString wildcardToRegExp(const QString &pattern)
+    {
+        QString rx;
+        for (int i = 0; i < pattern.size(); ++i) {
+            const QChar c = pattern[i];
+            if (c == QLatin1Char('*')) {
+                rx += QLatin1String(".*");
+            } else if (c == QLatin1Char('?')) {
+                rx += QLatin1Char('.');
+            } else if (c == QLatin1Char('[')) {
+                const int end = pattern.indexOf(QLatin1Char(']'), i + 1);
+                if (end < 0) {
+                    rx += QRegularExpression::escape(pattern.mid(i));
+                    break;
+                }
+                QString set = pattern.mid(i + 1, end - i - 1);
+                if (set.startsWith(QLatin1Char('!')))
+                    set[0] = QLatin1Char('^');
+                rx += QLatin1Char('[') + set + QLatin1Char(']');
+                i = end;
+            } else {
+                rx += QRegularExpression::escape(QString(c));
+            }
+        }
+        return rx;
+    }
+}
 
 SortFilterProxyModel::SortFilterProxyModel(QObject *parent) 
     : QSortFilterProxyModel(parent)
     , m_complete(false)
+    , m_filterGeneration(std::make_shared<std::atomic<quint64>>(0))
 {
+    m_filterTimer.setSingleShot(true);
+    connect(&m_filterTimer, &QTimer::timeout, this, &SortFilterProxyModel::applyFilter);
+    m_filterPool.setMaxThreadCount(1);
+
     connect(this, &QAbstractItemModel::rowsInserted, this, &SortFilterProxyModel::countChanged);
     connect(this, &QAbstractItemModel::rowsRemoved, this, &SortFilterProxyModel::countChanged);
     connect(this, &QAbstractItemModel::modelReset, this, &SortFilterProxyModel::countChanged);
     connect(this, &QAbstractItemModel::layoutChanged, this, &SortFilterProxyModel::countChanged);
 }
 
+SortFilterProxyModel::~SortFilterProxyModel()
+{
+    ++*m_filterGeneration;
+    m_filterPool.waitForDone();
+}
+
 int SortFilterProxyModel::count() const
 {
     return rowCount();
@@ -36,7 +112,10 @@ QObject *SortFilterProxyModel::source() const
 
 void SortFilterProxyModel::setSource(QObject *source)
 {
+    m_filter.valid = false;
+    m_sortKeys = dynamic_cast<const SortKeyModel *>(source);
     setSourceModel(qobject_cast<QAbstractItemModel *>(source));
+    watchSource();
 }
 
 QByteArray SortFilterProxyModel::sortRole() const
@@ -46,6 +125,7 @@ QByteArray SortFilterProxyModel::sortRole() const
 
 void SortFilterProxyModel::setSortRole(const QByteArray &role)
 {
+    EventMonitor::Scope monitorScope("SortFilterProxyModel::sort");
     if (m_sortRole != role) {
         m_sortRole = role;
         if (m_complete)
@@ -55,6 +135,7 @@ void SortFilterProxyModel::setSortRole(const QByteArray &role)
 
 void SortFilterProxyModel::setSortOrder(Qt::SortOrder order)
 {
+    EventMonitor::Scope monitorScope("SortFilterProxyModel::sort");
     QSortFilterProxyModel::sort(0, order);
 }
 
@@ -67,6 +148,7 @@ void SortFilterProxyModel::setFilterRole(const QByteArray &role)
 {
     if (m_filterRole != role) {
         m_filterRole = role;
+        m_filter.valid = false;
         if (m_complete)
             QSortFilterProxyModel::setFilterRole(roleKey(role));
     }
@@ -74,12 +156,17 @@ void SortFilterProxyModel::setFilterRole(const QByteArray &role)
 
 QString SortFilterProxyModel::filterString() const
 {
-    return filterRegExp().pattern();
+    return m_filterString;
 }
 
 void SortFilterProxyModel::setFilterString(const QString &filter)
 {
-    setFilterRegExp(QRegExp(filter, filterCaseSensitivity(), static_cast<QRegExp::PatternSyntax>(filterSyntax())));
+    m_filterString = filter;
+    if (m_filterDelay > 0) {
+        m_filterTimer.start(m_filterDelay);
+        return;
+    }
+    applyFilter();
 }
 
 SortFilterProxyModel::FilterSyntax SortFilterProxyModel::filterSyntax() const
@@ -89,9 +176,35 @@ SortFilterProxyModel::FilterSyntax SortFilterProxyModel::filterSyntax() const
 
 void SortFilterProxyModel::setFilterSyntax(SortFilterProxyModel::FilterSyntax syntax)
 {
+    m_filter = compileFilter(filterString(), syntax);
     setFilterRegExp(QRegExp(filterString(), filterCaseSensitivity(), static_cast<QRegExp::PatternSyntax>(syntax)));
 }
 
+int SortFilterProxyModel::filterDelay() const
+{
+    return m_filterDelay;
+}
+
+void SortFilterProxyModel::setFilterDelay(int delay)
+{
+    m_filterDelay = delay;
+}
+
+bool SortFilterProxyModel::isFilterApplied() const
+{
+    return !m_filterTimer.isActive() && !m_pendingFilter.valid && filterRegExp().pattern() == m_filterString;
+}
+
+bool SortFilterProxyModel::asynchronous() const
+{
+    return m_asynchronous;
+}
+
+void SortFilterProxyModel::setAsynchronous(bool asynchronous)
+{
+    m_asynchronous = asynchronous;
+}
+
 QVariantMap SortFilterProxyModel::get(int idx) const
 {
 	QVariantMap map;
@@ -128,6 +241,7 @@ void SortFilterProxyModel::classBegin()
 void SortFilterProxyModel::componentComplete()
 {
     m_complete = true;
+    m_filter.valid = false;
     if (!m_sortRole.isEmpty())
         QSortFilterProxyModel::setSortRole(roleKey(m_sortRole));
     if (!m_filterRole.isEmpty())
@@ -153,27 +267,292 @@ QHash<int, QByteArray> SortFilterProxyModel::roleNames() const
     return QHash<int, QByteArray>();
 }
 
-bool SortFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+SortFilterProxyModel::CompiledFilter SortFilterProxyModel::compileFilter(const QString &pattern, FilterSyntax syntax) const
 {
-    QRegExp rx = filterRegExp();
-    if (rx.isEmpty())
-        return true;
-    QAbstractItemModel *model = sourceModel();
-    if (filterRole().isEmpty()) {
-        QHash<int, QByteArray> roles = roleNames();
-        QHashIterator<int, QByteArray> it(roles);
-        while (it.hasNext()) {
-            it.next();
-            QModelIndex sourceIndex = model->index(sourceRow, 0, sourceParent);
-            QString key = model->data(sourceIndex, it.key()).toString();
-            if (key.contains(rx))
-                return true;
+    CompiledFilter filter;
+    filter.valid = true;
+    filter.caseSensitivity = filterCaseSensitivity();
+
+    QString literal = pattern;
+    bool isLiteral = false;
+    bool isPrefix = false;
+    switch (syntax) {
+    case FixedString:
+        isLiteral = true;
+        break;
+    case Wildcard:
+        // the match is not anchored, so leading and trailing stars change nothing
+        while (literal.startsWith(QLatin1Char('*')))
+            literal.remove(0, 1);
+        while (literal.endsWith(QLatin1Char('*')))
+            literal.chop(1);
+        isLiteral = !hasAnyOf(literal, QStringLiteral("*?["));
+        break;
+    case RegExp:
+        if (literal.startsWith(QLatin1Char('^'))) {
+            literal.remove(0, 1);
+            isPrefix = !hasAnyOf(literal, kRegExpSpecialChars);
+            if (!isPrefix)
+                literal = pattern;
+        } else {
+            isLiteral = !hasAnyOf(literal, kRegExpSpecialChars);
         }
-        return false;
+        break;
     }
+
+    if (pattern.isEmpty() || ((isLiteral || isPrefix) && literal.isEmpty())) {
+        filter.kind = CompiledFilter::AcceptAll;
+    } else if (isLiteral) {
+        filter.kind = CompiledFilter::Contains;
+        filter.literal = literal;
+        filter.matcher = QStringMatcher(literal, filter.caseSensitivity);
+    } else if (isPrefix) {
+        filter.kind = CompiledFilter::Prefix;
+        filter.literal = literal;
+    } else {
+        filter.kind = CompiledFilter::Regex;
+        filter.regex = QRegularExpression(syntax == Wildcard ? wildcardToRegExp(pattern) : pattern,
+            filter.caseSensitivity == Qt::CaseInsensitive ? QRegularExpression::CaseInsensitiveOption : QRegularExpression::NoPatternOption);
+        filter.regex.optimize();
+    }
+
+    // bool roles are stringified as "true"/"false", so these literals are compared as bools
+    if (filter.kind == CompiledFilter::Contains) {
+        filter.boolValue = literal.compare(QLatin1String("true"), filter.caseSensitivity) == 0;
+        filter.matchesBool = filter.boolValue || literal.compare(QLatin1String("false"), filter.caseSensitivity) == 0;
+    }
+
+    if (m_filterRole.isEmpty()) {
+        filter.roles = roleNames().keys().toVector();
+    } else {
+        filter.roles.push_back(roleKey(m_filterRole));
+        const auto *searchable = dynamic_cast<const SearchableModel *>(sourceModel());
+        if (filter.kind == CompiledFilter::Contains && filter.caseSensitivity == Qt::CaseInsensitive
+            && searchable && searchable->isSearchRole(filter.roles.front())) {
+            filter.searchable = searchable;
+            filter.searchQuery = filter.literal.toCaseFolded();
+        }
+    }
+
+    return filter;
+}
+
+const SortFilterProxyModel::CompiledFilter &SortFilterProxyModel::compiledFilter() const
+{
+    // case sensitivity is a base class property which is changed without notifying us
+    // the installed pattern, a newer filter string may still be waiting for its async pass
+    if (!m_filter.valid || m_filter.caseSensitivity != filterCaseSensitivity())
+        m_filter = compileFilter(filterRegExp().pattern(), filterSyntax());
+    return m_filter;
+}
+
+bool SortFilterProxyModel::acceptsValue(const CompiledFilter &filter, const QVariant &value)
+{
+    if (filter.matchesBool && value.type() == QVariant::Bool)
+        return value.toBool() == filter.boolValue;
+    return acceptsText(filter, value.toString());
+}
+
+bool SortFilterProxyModel::acceptsText(const CompiledFilter &filter, const QString &text)
+{
+    switch (filter.kind) {
+    case CompiledFilter::Contains:
+        return filter.matcher.indexIn(text) >= 0;
+    case CompiledFilter::Prefix:
+        return text.startsWith(filter.literal, filter.caseSensitivity);
+    case CompiledFilter::Regex:
+        return filter.regex.match(text).hasMatch();
+    case CompiledFilter::AcceptAll:
+        break;
+    }
+    return true;
+}
+
+bool SortFilterProxyModel::acceptsRow(const CompiledFilter &filter, int sourceRow, const QModelIndex &sourceParent) const
+{
+    if (filter.kind == CompiledFilter::AcceptAll)
+        return true;
+    if (filter.searchable)
+        return filter.searchable->searchMatches(sourceRow, filter.searchQuery);
+    QAbstractItemModel *model = sourceModel();
     QModelIndex sourceIndex = model->index(sourceRow, 0, sourceParent);
     if (!sourceIndex.isValid())
-        return true;
-    QString key = model->data(sourceIndex, roleKey(filterRole())).toString();
-    return key.contains(rx);
+        return !m_filterRole.isEmpty();
+    for (int role : filter.roles) {
+        if (acceptsValue(filter, model->data(sourceIndex, role)))
+            return true;
+    }
+    return false;
+}
+
+bool SortFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+    if (!m_accepted.empty())
+        return size_t(sourceRow) < m_accepted.size() ? bool(m_accepted[sourceRow]) : true;
+    return acceptsRow(compiledFilter(), sourceRow, sourceParent);
+}
+
+bool SortFilterProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
+{
+    const int role = QSortFilterProxyModel::sortRole();
+    if (m_sortKeys && m_sortKeys->hasSortKey(role))
+        return m_sortKeys->sortKeyLess(left.row(), right.row(), role);
+    return QSortFilterProxyModel::lessThan(left, right);
+}
+
+void SortFilterProxyModel::applyFilter()
+{
+    EventMonitor::Scope monitorScope("SortFilterProxyModel::filter");
+    m_filterTimer.stop();
+    auto filter = compileFilter(m_filterString, filterSyntax());
+    // only a single role of a model which can't answer the query itself is worth a worker pass
+    if (m_asynchronous && m_complete && sourceModel() && filter.kind != CompiledFilter::AcceptAll
+        && !filter.searchable && filter.roles.size() == 1) {
+        startAsyncFilter(std::move(filter));
+        return;
+    }
+    ++*m_filterGeneration;
+    m_pendingFilter = CompiledFilter();
+    m_pendingRows.clear();
+    installFilter(std::move(filter));
+}
+
+void SortFilterProxyModel::installFilter(CompiledFilter filter)
+{
+    m_filter = std::move(filter);
+    if (filterRegExp().pattern() == m_filterString)
+        invalidateFilter();
+    else
+        setFilterRegExp(QRegExp(m_filterString, filterCaseSensitivity(), static_cast<QRegExp::PatternSyntax>(filterSyntax())));
+}
+
+void SortFilterProxyModel::startAsyncFilter(CompiledFilter filter)
+{
+    const quint64 generation = ++*m_filterGeneration;
+    const int role = filter.roles.front();
+    if (m_snapshotRole != role) {
+        m_snapshotRole = role;
+        m_snapshot.clear();
+        snapshotRows(0, sourceModel()->rowCount() - 1);
+    }
+
+    m_pendingFilter = filter;
+    m_pendingLost = false;
+    m_pendingRows.resize(size_t(m_snapshot.size()));
+    for (size_t row = 0; row < m_pendingRows.size(); ++row)
+        m_pendingRows[row] = int(row);
+
+    auto latest = m_filterGeneration;
+    m_filterPool.start(new FunctionRunnable([this, filter = std::move(filter), snapshot = m_snapshot, latest, generation]()
+    {
+        std::vector<bool> accepted(size_t(snapshot.size()), false);
+        for (int row = 0; row < snapshot.size(); ++row) {
+            if ((row & 0x3ff) == 0 && *latest != generation)
+                return;
+            accepted[row] = acceptsText(filter, snapshot[row]);
+        }
+        // the destructor waits for the pool, so the proxy is still alive here
+        QMetaObject::invokeMethod(this, [this, generation, accepted = std::move(accepted)]() mutable
+        {
+            onAsyncFilterDone(generation, std::move(accepted));
+        }, Qt::QueuedConnection);
+    }));
+}
+
+void SortFilterProxyModel::onAsyncFilterDone(quint64 generation, std::vector<bool> accepted)
+{
+    EventMonitor::Scope monitorScope("SortFilterProxyModel::filter");
+    if (generation != *m_filterGeneration)
+        return;
+
+    // the source has moved on a little while the job ran: rows which kept their snapshot
+    // row take its result, only the inserted and changed ones are checked here
+    if (m_pendingLost) {
+        // the rows were reset or reordered, nothing of the result applies
+        startAsyncFilter(std::move(m_pendingFilter));
+        return;
+    }
+    auto pendingRows = std::move(m_pendingRows);
+    m_pendingRows.clear();
+
+    std::vector<bool> rows(pendingRows.size(), false);
+    for (size_t row = 0; row < pendingRows.size(); ++row) {
+        const int origin = pendingRows[row];
+        rows[row] = origin >= 0 && size_t(origin) < accepted.size()
+            ? bool(accepted[origin])
+            : acceptsRow(m_pendingFilter, int(row), QModelIndex());
+    }
+
+    m_accepted = std::move(rows);
+    installFilter(std::move(m_pendingFilter));
+    m_pendingFilter = CompiledFilter();
+    m_accepted.clear();
+}
+
+void SortFilterProxyModel::watchSource()
+{
+    for (const auto &connection : m_sourceConnections)
+        disconnect(connection);
+    m_sourceConnections.clear();
+    dropSnapshot();
+
+    QAbstractItemModel *model = sourceModel();
+    if (!model)
+        return;
+
+    m_sourceConnections.push_back(connect(model, &QAbstractItemModel::rowsInserted, this, &SortFilterProxyModel::onSourceRowsInserted));
+    m_sourceConnections.push_back(connect(model, &QAbstractItemModel::rowsRemoved, this, &SortFilterProxyModel::onSourceRowsRemoved));
+    m_sourceConnections.push_back(connect(model, &QAbstractItemModel::dataChanged, this, &SortFilterProxyModel::onSourceDataChanged));
+    // rows change places, the snapshot is taken again by the next pass
+    m_sourceConnections.push_back(connect(model, &QAbstractItemModel::rowsMoved, this, &SortFilterProxyModel::dropSnapshot));
+    m_sourceConnections.push_back(connect(model, &QAbstractItemModel::modelReset, this, &SortFilterProxyModel::dropSnapshot));
+    m_sourceConnections.push_back(connect(model, &QAbstractItemModel::layoutChanged, this, &SortFilterProxyModel::dropSnapshot));
+}
+
+void SortFilterProxyModel::snapshotRows(int first, int last)
+{
+    QAbstractItemModel *model = sourceModel();
+    for (int row = first; row <= last; ++row)
+        m_snapshot.insert(row, model->data(model->index(row, 0), m_snapshotRole).toString());
+}
+
+void SortFilterProxyModel::dropSnapshot()
+{
+    m_snapshotRole = -1;
+    m_snapshot.clear();
+    m_pendingLost = m_pendingFilter.valid;
+    m_pendingRows.clear();
+}
+
+void SortFilterProxyModel::onSourceRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid())
+        return;
+    if (m_snapshotRole >= 0)
+        snapshotRows(first, last);
+    if (!m_pendingRows.empty())
+        m_pendingRows.insert(m_pendingRows.begin() + std::min<size_t>(size_t(first), m_pendingRows.size()), size_t(last - first + 1), -1);
+}
+
+void SortFilterProxyModel::onSourceRowsRemoved(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid())
+        return;
+    if (m_snapshotRole >= 0)
+        m_snapshot.remove(first, last - first + 1);
+    if (size_t(last) < m_pendingRows.size())
+        m_pendingRows.erase(m_pendingRows.begin() + first, m_pendingRows.begin() + last + 1);
+}
+
+void SortFilterProxyModel::onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
+{
+    if (m_snapshotRole < 0 || (!roles.isEmpty() && !roles.contains(m_snapshotRole)))
+        return;
+
+    QAbstractItemModel *model = sourceModel();
+    for (int row = topLeft.row(); row <= bottomRight.row() && row < m_snapshot.size(); ++row) {
+        m_snapshot[row] = model->data(model->index(row, 0), m_snapshotRole).toString();
+        if (size_t(row) < m_pendingRows.size())
+            m_pendingRows[row] = -1;
+    }
 }
@@ -13,9 +13,21 @@
 // limitations under the License.
 #pragma once
 
+#include <QtCore/qregularexpression.h>
 #include <QtCore/qsortfilterproxymodel.h>
+#include <QtCore/qstringmatcher.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qtimer.h>
+#include <QtCore/qvector.h>
 #include <QtQml/qqmlparserstatus.h>
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class SearchableModel;
+class SortKeyModel;
+
 class SortFilterProxyModel : public QSortFilterProxyModel, public QQmlParserStatus
 {
     Q_OBJECT
@@ -30,11 +42,14 @@ class SortFilterProxyModel : public QSortFilterProxyModel, public QQmlParserStat
     Q_PROPERTY(QByteArray filterRole READ filterRole WRITE setFilterRole)
     Q_PROPERTY(QString filterString READ filterString WRITE setFilterString)
     Q_PROPERTY(FilterSyntax filterSyntax READ filterSyntax WRITE setFilterSyntax)
+    Q_PROPERTY(int filterDelay READ filterDelay WRITE setFilterDelay)
+    Q_PROPERTY(bool asynchronous READ asynchronous WRITE setAsynchronous)
 
     Q_ENUMS(FilterSyntax)
 
 public:
     explicit SortFilterProxyModel(QObject *parent = 0);
+    ~SortFilterProxyModel() override;
 
     QObject *source() const;
     void setSource(QObject *source);
@@ -59,6 +74,18 @@ public:
     FilterSyntax filterSyntax() const;
     void setFilterSyntax(FilterSyntax syntax);
 
+    // Milliseconds to wait for the filter string to settle before it is applied
+    int filterDelay() const;
+    void setFilterDelay(int delay);
+    // the rows are filtered by the current filter string, no delay or worker pass is pending
+    bool isFilterApplied() const;
+
+    // Evaluate the filter on a worker thread over a snapshot of the filter role texts,
+    // the proxy switches to the new filter and rows in one pass when the result is ready.
+    // Rows changed while the worker runs are checked again on their own
+    bool asynchronous() const;
+    void setAsynchronous(bool asynchronous);
+
     int count() const;
     Q_INVOKABLE QVariantMap get(int index) const;
     Q_INVOKABLE QVariant getRoleValue(int index, QByteArray roleName) const;
@@ -73,9 +100,76 @@ protected:
     int roleKey(const QByteArray &role) const;
     QHash<int, QByteArray> roleNames() const;
     bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const;
+    bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
 
 private:
+    // Filter state derived from the pattern, syntax, case sensitivity and role,
+    // built once per change instead of on every filterAcceptsRow call
+    struct CompiledFilter
+    {
+        enum Kind {
+            AcceptAll,
+            Contains,
+            Prefix,
+            Regex
+        };
+
+        bool valid = false;
+        Kind kind = AcceptAll;
+        Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive;
+        QVector<int> roles;
+        QString literal;
+        QStringMatcher matcher;
+        QRegularExpression regex;
+        // "true"/"false" patterns compare bool roles without string conversion
+        bool matchesBool = false;
+        bool boolValue = false;
+        // set when the source answers substring queries on the filter role itself
+        const SearchableModel *searchable = nullptr;
+        QString searchQuery;
+    };
+
+    CompiledFilter compileFilter(const QString &pattern, FilterSyntax syntax) const;
+    const CompiledFilter &compiledFilter() const;
+    static bool acceptsValue(const CompiledFilter &filter, const QVariant &value);
+    static bool acceptsText(const CompiledFilter &filter, const QString &text);
+    bool acceptsRow(const CompiledFilter &filter, int sourceRow, const QModelIndex &sourceParent) const;
+
+    void applyFilter();
+    void installFilter(CompiledFilter filter);
+    void startAsyncFilter(CompiledFilter filter);
+    void onAsyncFilterDone(quint64 generation, std::vector<bool> accepted);
+
+    void watchSource();
+    void snapshotRows(int first, int last);
+    void dropSnapshot();
+    void onSourceRowsInserted(const QModelIndex &parent, int first, int last);
+    void onSourceRowsRemoved(const QModelIndex &parent, int first, int last);
+    void onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+
+    mutable CompiledFilter m_filter;
     bool m_complete;
+    QString m_filterString;
+
+    int m_filterDelay = 0;
+    QTimer m_filterTimer;
+
+    bool m_asynchronous = false;
+    QThreadPool m_filterPool;
+    // bumped by every new filter, running jobs stop as soon as they see a newer value
+    std::shared_ptr<std::atomic<quint64>> m_filterGeneration;
+    // filter role values of the source rows, kept in step with the source between passes
+    int m_snapshotRole = -1;
+    QVector<QString> m_snapshot;
+    // filter of the running job, installed together with its result, and the snapshot row
+    // each source row had when the job started: -1 for rows inserted or changed since
+    CompiledFilter m_pendingFilter;
+    std::vector<int> m_pendingRows;
+    bool m_pendingLost = false;
+    QVector<QMetaObject::Connection> m_sourceConnections;
+    const SortKeyModel *m_sortKeys = nullptr;
+    // accepted source rows of a finished job, valid only while it is being applied
+    std::vector<bool> m_accepted;
     QByteArray m_sortRole;
     QByteArray m_filterRole;
 };
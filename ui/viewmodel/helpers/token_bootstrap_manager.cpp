@@ -27,7 +27,15 @@ TokenBootstrapManager::TokenBootstrapManager()
                         const std::vector<beam::wallet::TxDescription>&)),
         SLOT(onTransactionsChanged(beam::wallet::ChangeAction,
                         const std::vector<beam::wallet::TxDescription>&)));
-    _wallet_model.getAsync()->getTransactions();
+
+    if (_wallet_model.isTransactionsLoaded())
+    {
+        applyTransactions(beam::wallet::ChangeAction::Reset, _wallet_model.getTransactions());
+    }
+    else
+    {
+        _wallet_model.loadTransactions();
+    }
 }
 
 TokenBootstrapManager::~TokenBootstrapManager() {}
@@ -35,6 +43,11 @@ TokenBootstrapManager::~TokenBootstrapManager() {}
 void TokenBootstrapManager::onTransactionsChanged(
     beam::wallet::ChangeAction action,
     const std::vector<beam::wallet::TxDescription>& items)
+{
+    applyTransactions(action, _wallet_model.getTransactions(items));
+}
+
+void TokenBootstrapManager::applyTransactions(beam::wallet::ChangeAction action, const WalletModel::TxList& items)
 {
     switch (action)
     {
@@ -44,7 +57,7 @@ void TokenBootstrapManager::onTransactionsChanged(
     case beam::wallet::ChangeAction::Updated:
         for (const auto& item : items)
         {
-            if (const auto& id = item.GetTxID(); id)
+            if (const auto& id = item->GetTxID(); id)
             {
                 _myTxIds.insert(*id);
             }
@@ -53,7 +66,7 @@ void TokenBootstrapManager::onTransactionsChanged(
     case beam::wallet::ChangeAction::Removed:
         for (const auto& item : items)
         {
-            if (const auto& id = item.GetTxID(); id)
+            if (const auto& id = item->GetTxID(); id)
             {
                 _myTxIds.erase(*id);
             }
@@ -91,9 +104,9 @@ void TokenBootstrapManager::checkTokenForDuplicate(const QString& token)
     auto txIdValue = txId.value();
     _tokensInProgress[txIdValue] = token;
 
-    _myTxIds.empty()
-        ? _wallet_model.getAsync()->getTransactions()
-        : checkIsTxPreviousAccepted();
+    _wallet_model.isTransactionsLoaded()
+        ? checkIsTxPreviousAccepted()
+        : _wallet_model.loadTransactions();
 }
 
 void TokenBootstrapManager::checkIsTxPreviousAccepted()
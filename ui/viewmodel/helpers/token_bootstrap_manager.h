@@ -38,6 +38,7 @@ signals:
     void tokenOwnGenerated(const QString& token);
 
 private:
+    void applyTransactions(beam::wallet::ChangeAction action, const WalletModel::TxList& items);
     void checkIsTxPreviousAccepted();
 
     WalletModel& _wallet_model;
@@ -141,6 +141,22 @@ bool NotificationItem::operator==(const NotificationItem& other) const
     return getID() == other.getID();
 }
 
+uint32_t NotificationItem::compare(const NotificationItem& other) const
+{
+    uint32_t changes = NoChanges;
+    if (m_notification.m_state != other.m_notification.m_state)
+    {
+        changes |= StateChanged;
+    }
+    if (m_notification.m_type != other.m_notification.m_type
+        || m_notification.m_createTime != other.m_notification.m_createTime
+        || m_notification.m_content != other.m_notification.m_content)
+    {
+        changes |= ContentChanged;
+    }
+    return changes;
+}
+
 ECC::uintBig NotificationItem::getID() const
 {
     return m_notification.m_ID;
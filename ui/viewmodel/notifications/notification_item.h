@@ -24,9 +24,18 @@ class NotificationItem : public QObject
     Q_OBJECT
 
 public:
+    // Properties which differ between two snapshots of the same notification
+    enum Changes : uint32_t
+    {
+        NoChanges      = 0,
+        StateChanged   = 1 << 0,
+        ContentChanged = 1 << 1
+    };
+
     NotificationItem() = default;
     NotificationItem(const beam::wallet::Notification&);
     bool operator==(const NotificationItem& other) const;
+    uint32_t compare(const NotificationItem& other) const;
 
     QDateTime timeCreated() const;
     beam::Timestamp getTimestamp() const;
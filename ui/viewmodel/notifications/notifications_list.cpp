@@ -15,6 +15,7 @@
 #include "notifications_list.h"
 
 NotificationsList::NotificationsList()
+    : ListModel([](const auto& notification) { return notification->getID(); })
 {
 }
 
@@ -77,3 +78,25 @@ QVariant NotificationsList::data(const QModelIndex &index, int role) const
             return QVariant();
     }
 }
+
+QVector<int> NotificationsList::changedRoles(const std::shared_ptr<NotificationItem>& prev, const std::shared_ptr<NotificationItem>& next) const
+{
+    QVector<int> roles;
+    const auto changes = prev->compare(*next);
+    if (changes & NotificationItem::StateChanged)
+    {
+        // unread notifications are sorted first
+        roles << static_cast<int>(Roles::State) << static_cast<int>(Roles::TimeCreatedSort);
+    }
+    if (changes & NotificationItem::ContentChanged)
+    {
+        roles << static_cast<int>(Roles::TimeCreated) << static_cast<int>(Roles::DateCreated)
+              << static_cast<int>(Roles::Title) << static_cast<int>(Roles::Message)
+              << static_cast<int>(Roles::Type);
+        if (!(changes & NotificationItem::StateChanged))
+        {
+            roles << static_cast<int>(Roles::TimeCreatedSort);
+        }
+    }
+    return roles;
+}
@@ -18,7 +18,7 @@
 #include "viewmodel/helpers/list_model.h"
 #include <QLocale>
 
-class NotificationsList : public ListModel<std::shared_ptr<NotificationItem>>
+class NotificationsList : public ListModel<std::shared_ptr<NotificationItem>, ECC::uintBig, RawKeyHash>
 {
     Q_OBJECT
 
@@ -39,6 +39,10 @@ public:
 
     QVariant data(const QModelIndex &index, int role) const override;
     QHash<int, QByteArray> roleNames() const override;
+
+protected:
+    QVector<int> changedRoles(const std::shared_ptr<NotificationItem>& prev, const std::shared_ptr<NotificationItem>& next) const override;
+
 private:
     QLocale m_locale; // default locale
 };
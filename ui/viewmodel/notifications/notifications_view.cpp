@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "notifications_view.h"
+#include "model/event_monitor.h"
 
 #include "utility/logger.h"
 #include "wallet/client/extensions/news_channels/interface.h"
@@ -79,6 +80,8 @@ void NotificationsViewModel::activateAddress(const ECC::uintBig& id)
 
 void NotificationsViewModel::onNotificationsDataModelChanged(ChangeAction action, const std::vector<Notification>& notifications)
 {
+    EventMonitor::Scope monitorScope("NotificationsViewModel::onNotificationsDataModelChanged");
+
     std::vector<std::shared_ptr<NotificationItem>> modifiedNotifications;
     modifiedNotifications.reserve(notifications.size());
 
@@ -35,7 +35,12 @@ SendSwapViewModel::SendSwapViewModel()
     , _minimalBeamFeeGrothes(minimalFee(Currency::CurrBeam, false))
 {
     connect(&_walletModel, &WalletModel::changeCalculated,  this,  &SendSwapViewModel::onChangeCalculated);
-    connect(&_walletModel, &WalletModel::walletStatusChanged, this, &SendSwapViewModel::recalcAvailable);
+    connect(&_walletModel, &WalletModel::assetBalanceChanged, this, [this] (beam::Asset::ID assetId) {
+        if (assetId == beam::Asset::s_BeamID)
+        {
+            recalcAvailable();
+        }
+    });
     connect(&_exchangeRatesManager, SIGNAL(rateUnitChanged()), SIGNAL(secondCurrencyUnitNameChanged()));
     connect(&_exchangeRatesManager, SIGNAL(activeRateChanged()), SIGNAL(secondCurrencyRateChanged()));
     connect(&_walletModel, &WalletModel::shieldedCoinsSelectionCalculated, this, &SendSwapViewModel::onShieldedCoinsSelectionCalculated);
@@ -0,0 +1,357 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ui_scenario.h"
+#include "model/app_model.h"
+#include "model/process_memory.h"
+#include "viewmodel/wallet/tx_filter_proxy.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QSaveFile>
+
+#include <algorithm>
+
+#include "utility/logger.h"
+
+namespace
+{
+    const char* kPasswordVariable = "BEAM_UI_SCENARIO_PASSWORD";
+    const char* kReportFileName = "ui_scenario.json";
+    // matches ids, amounts and addresses alike, so the filter has work to do
+    const char* kSearchText = "1";
+
+    const int kPollIntervalMs = 20;
+    const auto kQuietPeriod = std::chrono::milliseconds(500);
+    const auto kStepTimeout = std::chrono::seconds(120);
+
+    template <typename Duration>
+    double toMilliseconds(Duration duration)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration).count() / 1000.0;
+    }
+
+    double percentile(const std::vector<int64_t>& sorted, double p)
+    {
+        return sorted.empty() ? 0. : sorted[static_cast<size_t>(p * (sorted.size() - 1))] / 1000.0;
+    }
+}
+
+UiScenario::UiScenario(QQuickWindow& window, bool quit)
+    : m_window(window)
+    , m_quit(quit)
+    , m_scenarioStarted(Clock::now())
+{
+    m_steps =
+    {
+        {
+            "open_wallet",
+            [this] ()
+            {
+                auto password = find("openWalletPassword");
+                auto button = find("openWalletButton");
+                if (!password || !button)
+                {
+                    return false;
+                }
+                password->setProperty("text", QString::fromLocal8Bit(qgetenv(kPasswordVariable)));
+                QMetaObject::invokeMethod(button, "clicked");
+                return true;
+            },
+            [this] () { return find("main") && find("txTable"); }
+        },
+        pageStep("transactions", "wallet", "txTable"),
+        {
+            "search",
+            [this] ()
+            {
+                auto searchBox = find("txSearchBox");
+                return txProxy() && searchBox && searchBox->setProperty("text", QString(kSearchText));
+            },
+            [this] ()
+            {
+                // the search delay is over and the list has selected the matching rows
+                auto proxy = txProxy();
+                return proxy && proxy->searchText() == QString(kSearchText) && proxy->isSelectionApplied();
+            }
+        },
+        {
+            "sort_by_amount",
+            [this] ()
+            {
+                auto table = find("txTable");
+                auto proxy = txProxy();
+                if (!table || !proxy)
+                {
+                    return false;
+                }
+                const auto columnCount = table->property("columnCount").toInt();
+                for (int i = 0; i < columnCount; ++i)
+                {
+                    QVariant column;
+                    QMetaObject::invokeMethod(table, "getColumn", Q_RETURN_ARG(QVariant, column), Q_ARG(QVariant, i));
+                    if (auto object = column.value<QObject*>(); object && object->property("role").toString().startsWith("amount"))
+                    {
+                        // the proxy sorts right away when the binding gives it the new role
+                        m_sortRole = object->property("role").toString().toUtf8() + "Sort";
+                        m_layoutConnection = connect(proxy, &QAbstractItemModel::layoutChanged, this, [this] () { m_layoutChanged = true; });
+                        return table->setProperty("sortIndicatorColumn", i);
+                    }
+                }
+                return false;
+            },
+            [this] ()
+            {
+                auto proxy = txProxy();
+                return proxy && proxy->sortRole() == m_sortRole && m_layoutChanged;
+            }
+        },
+        pageStep("utxo", "utxo", "utxoTable"),
+        pageStep("atomic_swaps", "atomic_swap", "atomicSwapView"),
+        {
+            "receive_address",
+            [this] ()
+            {
+                auto main = find("main");
+                return main && QMetaObject::invokeMethod(main, "openReceiveDialog", Q_ARG(QVariant, QString()));
+            },
+            [this] ()
+            {
+                auto viewModel = find("receiveViewModel");
+                return viewModel && !viewModel->property("receiverAddress").toString().isEmpty();
+            }
+        }
+    };
+
+    // both come from the render thread when the scene graph runs threaded
+    connect(&m_window, &QQuickWindow::beforeSynchronizing, this, &UiScenario::onBeforeSynchronizing, Qt::DirectConnection);
+    connect(&m_window, &QQuickWindow::frameSwapped, this, &UiScenario::onFrameSwapped, Qt::DirectConnection);
+
+    connect(&m_pollTimer, &QTimer::timeout, this, &UiScenario::poll);
+    m_pollTimer.start(kPollIntervalMs);
+
+    LOG_INFO() << "UI scenario: " << m_steps.size() << " steps";
+    beginStep();
+}
+
+UiScenario::~UiScenario()
+{
+    disconnect(&m_window, nullptr, this, nullptr);
+}
+
+UiScenario::Step UiScenario::pageStep(const char* name, const char* page, const char* target)
+{
+    return
+    {
+        name,
+        [this, page, target] ()
+        {
+            auto main = find("main");
+            if (!main)
+            {
+                return false;
+            }
+            // the page being replaced may still be around for a moment
+            m_previousTarget = find(target);
+            return QMetaObject::invokeMethod(main, "updateItem", Q_ARG(QVariant, QString(page)), Q_ARG(QVariant, QVariant()));
+        },
+        [this, target] ()
+        {
+            auto object = find(target);
+            return object && object != m_previousTarget;
+        }
+    };
+}
+
+void UiScenario::poll()
+{
+    const auto now = Clock::now();
+    const auto& step = m_steps[m_current];
+
+    if (now - m_stepStarted > kStepTimeout)
+    {
+        finishStep(false, m_acted ? "no result in time" : "nothing to act on");
+        return;
+    }
+
+    if (!m_acted)
+    {
+        if (step.start())
+        {
+            m_acted = true;
+            m_actedAt = Clock::now();
+            std::lock_guard<std::mutex> lock(m_framesMutex);
+            m_swaps.clear();
+            m_renderMicros.clear();
+        }
+        return;
+    }
+
+    if (!m_done)
+    {
+        if (step.isDone())
+        {
+            m_done = true;
+            m_doneAt = now;
+        }
+        return;
+    }
+
+    Clock::time_point lastFrame;
+    {
+        std::lock_guard<std::mutex> lock(m_framesMutex);
+        lastFrame = m_swaps.empty() ? m_doneAt : std::max(m_doneAt, m_swaps.back());
+    }
+    if (now - lastFrame >= kQuietPeriod)
+    {
+        finishStep(true, nullptr);
+    }
+}
+
+void UiScenario::beginStep()
+{
+    m_acted = false;
+    m_done = false;
+    m_stepStarted = Clock::now();
+    m_rssBefore = getCurrentRss();
+    m_previousTarget.clear();
+    disconnect(m_layoutConnection);
+    m_layoutChanged = false;
+}
+
+void UiScenario::finishStep(bool ok, const char* error)
+{
+    const auto& step = m_steps[m_current];
+
+    std::vector<Clock::time_point> swaps;
+    std::vector<int64_t> renderMicros;
+    {
+        std::lock_guard<std::mutex> lock(m_framesMutex);
+        swaps.swap(m_swaps);
+        renderMicros.swap(m_renderMicros);
+    }
+    std::sort(renderMicros.begin(), renderMicros.end());
+
+    // the longest time the user saw no new frame
+    auto longestGap = Clock::duration::zero();
+    auto previous = m_actedAt;
+    for (const auto& swap : swaps)
+    {
+        longestGap = std::max(longestGap, swap - previous);
+        previous = swap;
+    }
+
+    const auto settled = swaps.empty() ? m_doneAt : std::max(m_doneAt, swaps.back());
+    const auto rssAfter = getCurrentRss();
+
+    QJsonObject result;
+    result.insert("name", step.name);
+    result.insert("ok", ok);
+    if (!ok)
+    {
+        result.insert("error", error);
+    }
+    else
+    {
+        result.insert("settled_ms", toMilliseconds(settled - m_actedAt));
+        result.insert("result_ms", toMilliseconds(m_doneAt - m_actedAt));
+        result.insert("frames", static_cast<int>(swaps.size()));
+        result.insert("render_p50_ms", percentile(renderMicros, 0.5));
+        result.insert("render_p99_ms", percentile(renderMicros, 0.99));
+        result.insert("render_max_ms", percentile(renderMicros, 1.));
+        result.insert("longest_frame_gap_ms", toMilliseconds(longestGap));
+    }
+    result.insert("rss_before", static_cast<qint64>(m_rssBefore));
+    result.insert("rss_after", static_cast<qint64>(rssAfter));
+    m_results.append(result);
+
+    if (ok)
+    {
+        LOG_INFO() << "UI scenario: " << step.name << " settled in " << toMilliseconds(settled - m_actedAt) << " ms, "
+                   << swaps.size() << " frames";
+    }
+    else
+    {
+        LOG_WARNING() << "UI scenario: " << step.name << " failed, " << error;
+    }
+
+    // later steps depend on the earlier ones
+    if (!ok || ++m_current == m_steps.size())
+    {
+        report();
+        return;
+    }
+    beginStep();
+}
+
+void UiScenario::report()
+{
+    m_pollTimer.stop();
+
+    QJsonObject root;
+    root.insert("steps", m_results);
+    root.insert("total_ms", toMilliseconds(Clock::now() - m_scenarioStarted));
+    root.insert("peak_rss", static_cast<qint64>(getPeakRss()));
+    root.insert("events", AppModel::getInstance().getEventMonitor().toJson().object());
+
+    const auto path = QDir(QString::fromStdString(AppModel::getInstance().getSettings().getAppDataPath()))
+        .filePath(QString(WalletSettings::LogsFolder) + "/" + kReportFileName);
+    QSaveFile file(path);
+    if (file.open(QIODevice::WriteOnly) && file.write(QJsonDocument(root).toJson()) >= 0 && file.commit())
+    {
+        LOG_INFO() << "UI scenario finished, report: " << path.toStdString();
+    }
+    else
+    {
+        LOG_WARNING() << "UI scenario finished, failed to write " << path.toStdString();
+    }
+
+    if (m_quit)
+    {
+        QCoreApplication::quit();
+    }
+}
+
+QObject* UiScenario::find(const char* objectName) const
+{
+    const QString name(objectName);
+    if (auto object = m_window.findChild<QObject*>(name))
+    {
+        return object;
+    }
+    return m_window.contentItem()->findChild<QObject*>(name);
+}
+
+TxFilterProxyModel* UiScenario::txProxy() const
+{
+    auto table = find("txTable");
+    return table ? qobject_cast<TxFilterProxyModel*>(table->property("model").value<QObject*>()) : nullptr;
+}
+
+void UiScenario::onBeforeSynchronizing()
+{
+    m_syncStarted = Clock::now();
+}
+
+void UiScenario::onFrameSwapped()
+{
+    const auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(m_framesMutex);
+    m_swaps.push_back(now);
+    m_renderMicros.push_back(std::chrono::duration_cast<std::chrono::microseconds>(now - m_syncStarted).count());
+}
@@ -0,0 +1,91 @@
+// Copyright 2018 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QObject>
+#include <QJsonArray>
+#include <QPointer>
+#include <QTimer>
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+class QQuickWindow;
+class TxFilterProxyModel;
+
+// Walks through the main pages the way a user would and measures how long the UI takes
+// to settle after each step: open the wallet, transactions, search, sort by amount, UTXO,
+// atomic swaps and a new receive address. A step has settled when its result is in and
+// no frame has been rendered for a while; render times and the RSS growth are kept per step.
+// Enabled by debug/ui_scenario in settings.ini, the wallet password is taken from the
+// BEAM_UI_SCENARIO_PASSWORD environment variable. Meant to run with QT_QPA_PLATFORM=offscreen
+// over a throwaway wallet fed by debug/synthetic_load or debug/replay_callbacks.
+// Writes logs/ui_scenario.json and quits the application if debug/ui_scenario_quit is set
+class UiScenario : public QObject
+{
+    Q_OBJECT
+public:
+    UiScenario(QQuickWindow& window, bool quit);
+    ~UiScenario() override;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Step
+    {
+        const char* name;
+        std::function<bool()> start;    // false while the target is not there yet
+        std::function<bool()> isDone;   // the result is in, frames may still come
+    };
+
+    Step pageStep(const char* name, const char* page, const char* target);
+
+    void poll();
+    void beginStep();
+    void finishStep(bool ok, const char* error);
+    void report();
+
+    QObject* find(const char* objectName) const;
+    TxFilterProxyModel* txProxy() const;
+
+    // render thread
+    void onBeforeSynchronizing();
+    void onFrameSwapped();
+
+    QQuickWindow& m_window;
+    const bool m_quit;
+    std::vector<Step> m_steps;
+    size_t m_current = 0;
+    bool m_acted = false;
+    bool m_done = false;
+    Clock::time_point m_scenarioStarted;
+    Clock::time_point m_stepStarted;
+    Clock::time_point m_actedAt;
+    Clock::time_point m_doneAt;
+    uint64_t m_rssBefore = 0;
+    QPointer<QObject> m_previousTarget;
+    QByteArray m_sortRole;                  // the role the sort step asked for
+    bool m_layoutChanged = false;           // the proxy reordered its rows since the step acted
+    QMetaObject::Connection m_layoutConnection;
+    QJsonArray m_results;
+    QTimer m_pollTimer;
+
+    std::mutex m_framesMutex;
+    Clock::time_point m_syncStarted;        // render thread only
+    std::vector<Clock::time_point> m_swaps;
+    std::vector<int64_t> m_renderMicros;
+};
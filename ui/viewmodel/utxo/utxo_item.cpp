@@ -26,6 +26,28 @@ bool BaseUtxoItem::operator==(const BaseUtxoItem& other) const
     return getHash() == other.getHash();
 }
 
+uint32_t BaseUtxoItem::compare(const BaseUtxoItem& other) const
+{
+    uint32_t changes = NoChanges;
+    if (rawAmount() != other.rawAmount())
+    {
+        changes |= AmountChanged;
+    }
+    if (rawMaturity() != other.rawMaturity())
+    {
+        changes |= MaturityChanged;
+    }
+    if (status() != other.status())
+    {
+        changes |= StatusChanged;
+    }
+    if (type() != other.type())
+    {
+        changes |= TypeChanged;
+    }
+    return changes;
+}
+
 UtxoItem::UtxoItem(const beam::wallet::Coin& coin)
     : _coin{ coin }
 {
@@ -26,9 +26,19 @@ class BaseUtxoItem : public QObject
         Q_PROPERTY(int status           READ status                    CONSTANT)
         Q_PROPERTY(int type             READ type                      CONSTANT)
 public:
+    // Properties which differ between two snapshots of the same coin
+    enum Changes : uint32_t
+    {
+        NoChanges       = 0,
+        AmountChanged   = 1 << 0,
+        MaturityChanged = 1 << 1,
+        StatusChanged   = 1 << 2,
+        TypeChanged     = 1 << 3
+    };
 
     BaseUtxoItem() = default;
     bool operator==(const BaseUtxoItem& other) const;
+    uint32_t compare(const BaseUtxoItem& other) const;
 
     virtual uint64_t getHash() const = 0;
     virtual QString getAmountWithCurrency() const = 0;
@@ -15,6 +15,7 @@
 #include "utxo_item_list.h"
 
 UtxoItemList::UtxoItemList()
+    : ListModel([](const auto& utxo) { return utxo->getHash(); })
 {
 }
 
@@ -68,3 +69,25 @@ auto UtxoItemList::data(const QModelIndex &index, int role) const -> QVariant
     }
 }
 
+QVector<int> UtxoItemList::changedRoles(const std::shared_ptr<BaseUtxoItem>& prev, const std::shared_ptr<BaseUtxoItem>& next) const
+{
+    QVector<int> roles;
+    const auto changes = prev->compare(*next);
+    if (changes & BaseUtxoItem::AmountChanged)
+    {
+        roles << static_cast<int>(Roles::Amount) << static_cast<int>(Roles::AmountSort);
+    }
+    if (changes & BaseUtxoItem::MaturityChanged)
+    {
+        roles << static_cast<int>(Roles::Maturity) << static_cast<int>(Roles::MaturitySort);
+    }
+    if (changes & BaseUtxoItem::StatusChanged)
+    {
+        roles << static_cast<int>(Roles::Status) << static_cast<int>(Roles::StatusSort);
+    }
+    if (changes & BaseUtxoItem::TypeChanged)
+    {
+        roles << static_cast<int>(Roles::Type) << static_cast<int>(Roles::TypeSort);
+    }
+    return roles;
+}
@@ -17,7 +17,7 @@
 #include "utxo_item.h"
 #include "viewmodel/helpers/list_model.h"
 
-class UtxoItemList : public ListModel<std::shared_ptr<BaseUtxoItem>>
+class UtxoItemList : public ListModel<std::shared_ptr<BaseUtxoItem>, uint64_t>
 {
 
     Q_OBJECT
@@ -39,4 +39,7 @@ public:
 
     QVariant data(const QModelIndex &index, int role) const override;
     QHash<int, QByteArray> roleNames() const override;
+
+protected:
+    QVector<int> changedRoles(const std::shared_ptr<BaseUtxoItem>& prev, const std::shared_ptr<BaseUtxoItem>& next) const override;
 };
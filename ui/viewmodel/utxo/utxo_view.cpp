@@ -13,8 +13,10 @@
 // limitations under the License.
 
 #include "utxo_view.h"
+#include "model/event_monitor.h"
 #include "viewmodel/ui_helpers.h"
 #include "model/app_model.h"
+#include <unordered_set>
 using namespace beam;
 using namespace beam::wallet;
 using namespace std;
@@ -28,7 +30,7 @@ UtxoViewModel::UtxoViewModel()
     connect(&m_model, SIGNAL(shieldedCoinChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::ShieldedCoin>&)),
         SLOT(onShieldedCoinChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::ShieldedCoin>&)));
 
-    connect(&m_model, &WalletModel::walletStatusChanged, this, &UtxoViewModel::stateChanged);
+    connect(&m_model, &WalletModel::heightChanged, this, &UtxoViewModel::stateChanged);
     m_model.getAsync()->getUtxosStatus();
 }
 
@@ -49,6 +51,8 @@ QString UtxoViewModel::getCurrentStateHash() const
 
 void UtxoViewModel::onAllUtxoChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::Coin>& utxos)
 {
+    EventMonitor::Scope monitorScope("UtxoViewModel::onAllUtxoChanged");
+
     vector<shared_ptr<BaseUtxoItem>> modifiedItems;
     modifiedItems.reserve(utxos.size());
 
@@ -96,6 +100,8 @@ void UtxoViewModel::onAllUtxoChanged(beam::wallet::ChangeAction action, const st
 
 void UtxoViewModel::onShieldedCoinChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::ShieldedCoin>& items)
 {
+    EventMonitor::Scope monitorScope("UtxoViewModel::onShieldedCoinChanged");
+
     vector<shared_ptr<BaseUtxoItem>> modifiedItems;
     modifiedItems.reserve(items.size());
 
@@ -111,17 +117,24 @@ void UtxoViewModel::onShieldedCoinChanged(beam::wallet::ChangeAction action, con
     {
     case ChangeAction::Reset:
     {
-        // temporal hack
+        // shielded coins share the list with regular ones, so only stale shielded rows are dropped
+        // and the rest are updated in place
+        unordered_set<uint64_t> incoming;
+        for (const auto& item : modifiedItems)
+        {
+            incoming.insert(item->getHash());
+        }
+
         vector<shared_ptr<BaseUtxoItem>> toRemove;
         for (const auto& item : m_allUtxos)
         {
-            if (item->type() == UtxoViewType::EnType::Shielded)
+            if (item->type() == UtxoViewType::EnType::Shielded && incoming.find(item->getHash()) == incoming.end())
             {
                 toRemove.push_back(item);
             }
         }
         m_allUtxos.remove(toRemove);
-        m_allUtxos.insert(modifiedItems);
+        m_allUtxos.update(modifiedItems);
         break;
     }
 
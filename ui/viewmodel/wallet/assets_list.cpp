@@ -9,6 +9,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include "assets_list.h"
+#include "model/event_monitor.h"
 #include "model/app_model.h"
 
 AssetsList::AssetsList()
@@ -16,10 +17,18 @@ AssetsList::AssetsList()
 {
     connect(&_ermgr, &ExchangeRatesManager::rateUnitChanged, this, &AssetsList::onNewRates);
     connect(&_ermgr, &ExchangeRatesManager::activeRateChanged, this, &AssetsList::onNewRates);
-    connect(&_wallet, &WalletModel::walletStatusChanged, this, &AssetsList::onWalletStatus);
+    connect(&_wallet, &WalletModel::assetBalanceChanged, this, &AssetsList::onAssetBalanceChanged);
     connect(&_wallet, &WalletModel::transactionsChanged, this, &AssetsList::onTransactionsChanged);
     connect(&_amgr, &AssetsManager::assetInfo, this, &AssetsList::onAssetInfo);
-    _wallet.getAsync()->getTransactions();
+
+    if (_wallet.isTransactionsLoaded())
+    {
+        applyTransactions(beam::wallet::ChangeAction::Reset, _wallet.getTransactions(WalletModel::TxKind::Simple));
+    }
+    else
+    {
+        _wallet.loadTransactions();
+    }
 }
 
 QHash<int, QByteArray> AssetsList::roleNames() const
@@ -116,12 +125,9 @@ void AssetsList::onNewRates()
     touch(beam::Asset::s_BeamID);
 }
 
-void AssetsList::onWalletStatus()
+void AssetsList::onAssetBalanceChanged(beam::Asset::ID assetId)
 {
-    for(const auto& asset: m_list)
-    {
-        touch(asset->id());
-    }
+    touch(assetId);
 }
 
 void AssetsList::onAssetInfo(beam::Asset::ID assetId)
@@ -131,20 +137,13 @@ void AssetsList::onAssetInfo(beam::Asset::ID assetId)
 
 void AssetsList::onTransactionsChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& items)
 {
-    using namespace beam::wallet;
-
-    TxList modified;
+    EventMonitor::Scope monitorScope("AssetsList::onTransactionsChanged");
+    applyTransactions(action, _wallet.getTransactions(items, WalletModel::TxKind::Simple));
+}
 
-    for (const auto& tx : items)
-    {
-        if(const auto txType = tx.GetParameter<TxType>(TxParameterID::TransactionType))
-        {
-            if (txType == TxType::Simple || txType == TxType::PushTransaction)
-            {
-                modified.push_back(tx);
-            }
-        }
-    }
+void AssetsList::applyTransactions(beam::wallet::ChangeAction action, WalletModel::TxList modified)
+{
+    using namespace beam::wallet;
 
     switch(action)
     {
@@ -155,8 +154,8 @@ void AssetsList::onTransactionsChanged(beam::wallet::ChangeAction action, const
     case ChangeAction::Removed:
         for(auto del: modified)
         {
-            _txlist.erase(std::remove_if(_txlist.begin(), _txlist.end(), [&del](const TxDescription& t) {
-                return t.m_txId == del.m_txId;
+            _txlist.erase(std::remove_if(_txlist.begin(), _txlist.end(), [&del](const WalletModel::TxPtr& t) {
+                return t->m_txId == del->m_txId;
             }), _txlist.end());
         }
         break;
@@ -168,8 +167,8 @@ void AssetsList::onTransactionsChanged(beam::wallet::ChangeAction action, const
     case ChangeAction::Updated:
         for(auto repl: modified)
         {
-            std::replace_if(_txlist.begin(), _txlist.end(), [&repl](const TxDescription& t) {
-                return t.m_txId == repl.m_txId;
+            std::replace_if(_txlist.begin(), _txlist.end(), [&repl](const WalletModel::TxPtr& t) {
+                return t->m_txId == repl->m_txId;
             }, repl);
         }
         break;
@@ -184,13 +183,13 @@ void AssetsList::onTransactionsChanged(beam::wallet::ChangeAction action, const
     }
 
     for(const auto& tx: _txlist) {
-        if (auto obj = get(tx.m_assetId))
+        if (auto obj = get(tx->m_assetId))
         {
-            if(tx.m_status == wallet::TxStatus::Pending ||
-               tx.m_status == wallet::TxStatus::InProgress ||
-               tx.m_status == wallet::TxStatus::Registering)
+            if(tx->m_status == wallet::TxStatus::Pending ||
+               tx->m_status == wallet::TxStatus::InProgress ||
+               tx->m_status == wallet::TxStatus::Registering)
             {
-                if (tx.m_sender)
+                if (tx->m_sender)
                 {
                     obj->addOutTx();
                 }
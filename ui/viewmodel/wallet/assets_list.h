@@ -45,11 +45,12 @@ public:
 
 private slots:
     void onNewRates();
-    void onWalletStatus();
+    void onAssetBalanceChanged(beam::Asset::ID assetId);
     void onAssetInfo(beam::Asset::ID assetId);
     void onTransactionsChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& items);
 
 private:
+    void applyTransactions(beam::wallet::ChangeAction action, WalletModel::TxList modified);
     void touch(beam::Asset::ID id);
     std::shared_ptr<AssetObject> get(beam::Asset::ID id);
 
@@ -57,6 +58,5 @@ private:
     mutable ExchangeRatesManager _ermgr;
     WalletModel& _wallet;
 
-    typedef std::vector<beam::wallet::TxDescription> TxList;
-    TxList _txlist;
+    WalletModel::TxList _txlist;
 };
@@ -13,133 +13,375 @@
 // limitations under the License.
 #include "assets_manager.h"
 #include "model/app_model.h"
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <iterator>
+#include "utility/logger.h"
 
-AssetsManager::AssetsManager ()
-    : _wallet (*AppModel::getInstance().getWallet())
+namespace
+{
+    const char* kErrorIcon = "qrc:/assets/asset-err.svg";
+
+    const quint32 kCacheMagic = 0x42414348;     // "BACH"
+    const quint32 kCacheVersion = 2;
+    const auto kStreamVersion = QDataStream::Qt_5_12;
+    const int kSaveDelayMs = 2000;
+    const beam::Height kCacheLifetime = 1440 * 7;   // about a week of blocks
+    const beam::Height kRequestTimeout = 5;         // blocks to wait for the info before asking again
+
+    QString cachePath()
+    {
+        return QString::fromStdString(AppModel::getInstance().getSettings().getAssetsCacheStorage());
+    }
+
+    void writeBytes(QDataStream& s, const beam::ByteBuffer& value)
+    {
+        s << QByteArray(reinterpret_cast<const char*>(value.data()), static_cast<int>(value.size()));
+    }
+
+    beam::ByteBuffer readBytes(QDataStream& s)
+    {
+        QByteArray value;
+        s >> value;
+        return beam::ByteBuffer(value.begin(), value.end());
+    }
+
+    template <typename T>
+    void writeBlob(QDataStream& s, const T& value)
+    {
+        writeBytes(s, beam::toByteBuffer(value));
+    }
+
+    template <typename T>
+    void readBlob(QDataStream& s, T& value)
+    {
+        if (!beam::fromByteBuffer(readBytes(s), value))
+        {
+            s.setStatus(QDataStream::ReadCorruptData);
+        }
+    }
+
+    void writeAsset(QDataStream& s, const beam::wallet::WalletAsset& asset)
+    {
+        s << static_cast<quint32>(asset.m_ID);
+        writeBlob(s, asset.m_Value);
+        s << static_cast<quint64>(asset.m_LockHeight);
+        writeBytes(s, asset.m_Metadata.m_Value);
+        s << static_cast<quint64>(asset.m_RefreshHeight);
+    }
+
+    beam::wallet::WalletAsset readAsset(QDataStream& s)
+    {
+        beam::wallet::WalletAsset asset;
+        quint32 id = 0;
+        quint64 lockHeight = 0;
+        quint64 refreshHeight = 0;
+
+        s >> id;
+        readBlob(s, asset.m_Value);
+        s >> lockHeight;
+        asset.m_Metadata.m_Value = readBytes(s);
+        s >> refreshHeight;
+
+        asset.m_ID = id;
+        asset.m_LockHeight = lockHeight;
+        asset.m_Metadata.UpdateHash();
+        asset.m_RefreshHeight = refreshHeight;
+        return asset;
+    }
+
+    const QString& iconOf(beam::Asset::ID id)
+    {
+        static const QString icons[] =
+        {
+            "qrc:/assets/asset-0.svg",
+            "qrc:/assets/asset-1.svg",
+            "qrc:/assets/asset-2.svg",
+            "qrc:/assets/asset-3.svg"
+        };
+        return icons[id % std::size(icons)];
+    }
+
+    const QColor& colorOf(beam::Asset::ID id)
+    {
+        static const QColor colors[] =
+        {
+            QColor(115, 255, 124, 252),
+            QColor(216, 133, 255, 252),
+            QColor(255, 231, 90, 252),
+            QColor(79, 165, 255, 252)
+        };
+        return colors[id % std::size(colors)];
+    }
+}
+
+AssetsRegistry::Ptr AssetsRegistry::get()
+{
+    static std::weak_ptr<AssetsRegistry> s_registry;
+
+    const auto wallet = AppModel::getInstance().getWallet();
+    auto registry = s_registry.lock();
+    if (!registry || registry->_owner.lock() != wallet)
+    {
+        registry = std::make_shared<AssetsRegistry>(wallet);
+        s_registry = registry;
+    }
+    return registry;
+}
+
+AssetsRegistry::AssetsRegistry(const WalletModel::Ptr& wallet)
+    : _owner(wallet)
+    , _wallet(*wallet)
 {
     qRegisterMetaType<beam::Asset::ID>("beam::wallet::AssetID");
-    connect(&_wallet, &WalletModel::assetInfoChanged, this, &AssetsManager::onAssetInfo);
+    connect(&_wallet, &WalletModel::assetInfoChanged, this, &AssetsRegistry::onAssetInfo);
+    connect(&_wallet, &WalletModel::heightChanged, this, &AssetsRegistry::onHeightChanged);
 
-    _icons[0]  = "qrc:/assets/asset-0.svg";
-    _icons[1]  = "qrc:/assets/asset-1.svg";
-    _icons[2]  = "qrc:/assets/asset-2.svg";
-    _icons[3]  = "qrc:/assets/asset-3.svg";
+    _saveTimer.setSingleShot(true);
+    _saveTimer.setInterval(kSaveDelayMs);
+    connect(&_saveTimer, &QTimer::timeout, this, &AssetsRegistry::save);
 
-    _colors[0] = QColor(115, 255, 124, 252);
-    _colors[1] = QColor(216, 133, 255, 252);
-    _colors[2] = QColor(255, 231, 90, 252);
-    _colors[3] = QColor(79, 165, 255, 252);
+    load();
 }
 
-void AssetsManager::collectAssetInfo(beam::Asset::ID assetId)
+AssetsRegistry::~AssetsRegistry()
 {
-    if (assetId < 1)
+    if (_saveTimer.isActive())
     {
-        emit assetInfo(assetId);
+        save();
     }
-    else
+}
+
+void AssetsRegistry::collect(beam::Asset::ID assetId)
+{
+    if (_requested.emplace(assetId, _wallet.getCurrentHeight()).second)
     {
         _wallet.getAsync()->getAssetInfo(assetId);
     }
 }
 
-void AssetsManager::onAssetInfo(beam::Asset::ID id, const beam::wallet::WalletAsset& info)
+bool AssetsRegistry::isKnown(beam::Asset::ID assetId) const
 {
-    emit assetInfo(id);
-    _info[id] = info;
+    return _known.find(assetId) != _known.end();
 }
 
-AssetsManager::MetaPtr AssetsManager::getAsset(beam::Asset::ID id)
- {
-    const auto it = _info.find(id);
-    if (it != _info.end())
+const AssetsRegistry::Entry& AssetsRegistry::lookup(beam::Asset::ID assetId)
+{
+    if (const auto it = _known.find(assetId); it != _known.end())
     {
-        auto mptr = std::make_unique<beam::wallet::WalletAssetMeta>(it->second);
-        return mptr;
+        checkCached(assetId);
+        return it->second;
     }
 
-    collectAssetInfo(id);
-    return MetaPtr();
- }
+    collect(assetId);
+    auto it = _unknown.find(assetId);
+    if (it == _unknown.end())
+    {
+        it = _unknown.emplace(assetId, makeEntry(assetId, nullptr)).first;
+    }
+    return it->second;
+}
 
-QString AssetsManager::getIcon(beam::Asset::ID id)
+void AssetsRegistry::onAssetInfo(beam::Asset::ID assetId, const beam::wallet::WalletAsset& info)
 {
-     if (id < 1)
-     {
-         return "qrc:/assets/icon-beam.svg";
-     }
+    _assets[assetId] = info;
+    _cached.erase(assetId);
+    _requested.erase(assetId);
+    _saveTimer.start();
 
-     const auto it = _info.find(id);
-     if (it != _info.end())
-     {
-         auto idx = static_cast<int>(id % _icons.size());
-         return _icons[idx];
-     }
+    // a cached asset confirmed by the chain leaves the rows as they are
+    auto entry = makeEntry(assetId, &info);
+    if (const auto it = _known.find(assetId); it != _known.end()
+        && it->second.unitName == entry.unitName && it->second.name == entry.name)
+    {
+        return;
+    }
 
-     return "qrc:/assets/asset-err.svg";
+    // stored before the signal, so the receivers read the new names
+    _known[assetId] = std::move(entry);
+    _unknown.erase(assetId);
+    emit assetInfo(assetId);
 }
 
-QString AssetsManager::getUnitName(beam::Asset::ID id)
+void AssetsRegistry::onHeightChanged()
 {
-    if (id < 1)
+    // the asset may have been registered since, ids left unanswered for a while are asked again
+    // on the next lookup; a request still in flight is not sent twice
+    const auto height = _wallet.getCurrentHeight();
+    for (auto it = _requested.begin(); it != _requested.end();)
     {
-        return "BEAM";
+        if (height >= it->second + kRequestTimeout)
+        {
+            it = _requested.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
     }
+}
 
-    QString unitName;
-    if (auto meta = getAsset(id))
+AssetsRegistry::Entry AssetsRegistry::makeEntry(beam::Asset::ID assetId, const beam::wallet::WalletAsset* info) const
+{
+    Entry entry;
+    if (info)
+    {
+        beam::wallet::WalletAssetMeta meta(*info);
+        entry.unitName = QString::fromStdString(meta.GetUnitName());
+        entry.name = QString::fromStdString(meta.GetName());
+        entry.icon = iconOf(assetId);
+        entry.color = colorOf(assetId);
+    }
+    else
     {
-        unitName = meta->GetUnitName().c_str();
+        entry.icon = kErrorIcon;
+        entry.color = QColor(255, 116, 107, 252);
     }
 
-    if (unitName.isEmpty())
+    if (entry.unitName.isEmpty())
     {
-        std::ostringstream ss;
-        ss << "ASSET" << static_cast<int>(id);
-        unitName = ss.str().c_str();
+        entry.unitName = QString("ASSET%1").arg(assetId);
     }
+    if (entry.name.isEmpty())
+    {
+        entry.name = QString("Asset %1").arg(assetId);
+    }
+    return entry;
+}
 
-    return unitName;
+void AssetsRegistry::checkCached(beam::Asset::ID assetId)
+{
+    const auto currentHeight = _wallet.getCurrentHeight();
+    if (!currentHeight || _cached.erase(assetId) == 0)
+    {
+        // the age is judged once the tip is known
+        return;
+    }
+
+    const auto& asset = _assets[assetId];
+    if (asset.m_Value == beam::Zero || asset.m_RefreshHeight + kCacheLifetime < currentHeight)
+    {
+        collect(assetId);
+    }
 }
 
-QString AssetsManager::getName(beam::Asset::ID id)
+void AssetsRegistry::load()
 {
-    if (id < 1)
+    QFile file(cachePath());
+    if (!file.open(QIODevice::ReadOnly))
     {
-        return "Beam";
+        return;
     }
 
-    QString name;
-    if (auto meta = getAsset(id))
+    QDataStream stream(&file);
+    stream.setVersion(kStreamVersion);
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 count = 0;
+    stream >> magic >> version >> count;
+    if (magic != kCacheMagic || version != kCacheVersion)
     {
-        name = meta->GetName().c_str();
+        LOG_WARNING() << "Unexpected asset cache format, ignored";
+        return;
     }
 
-    if (name.isEmpty())
+    std::vector<beam::wallet::WalletAsset> assets;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+    {
+        assets.push_back(readAsset(stream));
+    }
+    if (stream.status() != QDataStream::Ok)
     {
-        std::ostringstream ss;
-        ss << "Asset " << static_cast<int>(id);
-        name = QString(ss.str().c_str());
+        LOG_WARNING() << "Asset cache is damaged, ignored";
+        return;
     }
 
-    return name;
+    for (auto& asset : assets)
+    {
+        const auto assetId = asset.m_ID;
+        _known[assetId] = makeEntry(assetId, &asset);
+        _cached.insert(assetId);
+        _assets[assetId] = std::move(asset);
+    }
 }
 
-QColor AssetsManager::getColor(beam::Asset::ID id)
+void AssetsRegistry::save()
+{
+    _saveTimer.stop();
+
+    QSaveFile file(cachePath());
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        LOG_WARNING() << "Failed to write the asset cache";
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(kStreamVersion);
+    stream << kCacheMagic << kCacheVersion << static_cast<quint32>(_assets.size());
+    for (const auto& p : _assets)
+    {
+        writeAsset(stream, p.second);
+    }
+    if (stream.status() != QDataStream::Ok || !file.commit())
+    {
+        LOG_WARNING() << "Failed to write the asset cache";
+    }
+}
+
+AssetsManager::AssetsManager()
+    : _registry(AssetsRegistry::get())
+{
+    connect(_registry.get(), &AssetsRegistry::assetInfo, this, &AssetsManager::assetInfo);
+}
+
+void AssetsManager::collectAssetInfo(beam::Asset::ID assetId)
+{
+    if (assetId < 1 || _registry->isKnown(assetId))
+    {
+        emit assetInfo(assetId);
+    }
+    else
+    {
+        _registry->collect(assetId);
+    }
+}
+
+QString AssetsManager::getIcon(beam::Asset::ID id)
 {
     if (id < 1)
     {
-        return QColor( 0, 246, 210, 252);
+        return "qrc:/assets/icon-beam.svg";
     }
+    return _registry->lookup(id).icon;
+}
 
-    const auto it = _info.find(id);
-     if (it != _info.end())
-     {
-         auto idx = static_cast<int>(id % _colors.size());
-         return _colors[idx];
-     }
+QString AssetsManager::getUnitName(beam::Asset::ID id)
+{
+    if (id < 1)
+    {
+        return "BEAM";
+    }
+    return _registry->lookup(id).unitName;
+}
 
-    return QColor( 255, 116, 107, 252);
+QString AssetsManager::getName(beam::Asset::ID id)
+{
+    if (id < 1)
+    {
+        return "Beam";
+    }
+    return _registry->lookup(id).name;
+}
+
+QColor AssetsManager::getColor(beam::Asset::ID id)
+{
+    if (id < 1)
+    {
+        return QColor( 0, 246, 210, 252);
+    }
+    return _registry->lookup(id).color;
 }
 
 QColor AssetsManager::getSelectionColor(beam::Asset::ID id)
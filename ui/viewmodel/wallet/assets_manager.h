@@ -15,9 +15,71 @@
 
 #include <QObject>
 #include <QColor>
+#include <QTimer>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include "model/wallet_model.h"
 
-// TODO: consider singleton for AssetsManager
+// Asset metadata of the opened wallet shared by all AssetsManager instances.
+// The metadata is parsed once when the info arrives and kept by id with the derived
+// names, icon and color. An unknown id is requested once however many rows and views ask
+// for it; a request which got no answer in a few blocks may be sent again.
+// The assets are kept in assets_cache.bin in the wallet folder, so the names are there
+// before the first paint. The file goes away with the wallet and holds only public asset
+// info, nothing about the ownership. A cached asset is asked again when it is first looked up if
+// it could have changed on chain: none of it is in circulation, so it can be destroyed and its id
+// reused, or it was refreshed too long ago
+class AssetsRegistry : public QObject
+{
+    Q_OBJECT
+public:
+    using Ptr = std::shared_ptr<AssetsRegistry>;
+
+    struct Entry
+    {
+        QString unitName;
+        QString name;
+        QString icon;
+        QColor  color;
+    };
+
+    // the registry of the current wallet, alive while someone holds it
+    static Ptr get();
+
+    explicit AssetsRegistry(const WalletModel::Ptr& wallet);
+    ~AssetsRegistry() override;
+
+    void collect(beam::Asset::ID assetId);
+    bool isKnown(beam::Asset::ID assetId) const;
+    // placeholder names are returned for an unknown asset and its info is requested
+    const Entry& lookup(beam::Asset::ID assetId);
+
+signals:
+    void assetInfo(beam::Asset::ID assetId);
+
+private slots:
+    void onAssetInfo(beam::Asset::ID, const beam::wallet::WalletAsset&);
+    void onHeightChanged();
+
+private:
+    Entry makeEntry(beam::Asset::ID assetId, const beam::wallet::WalletAsset* info) const;
+    void checkCached(beam::Asset::ID assetId);
+    void load();
+    void save();
+
+    std::weak_ptr<WalletModel> _owner;  // tells a new wallet from the one the registry was made for
+    WalletModel& _wallet;
+    std::unordered_map<beam::Asset::ID, Entry> _known;
+    std::unordered_map<beam::Asset::ID, Entry> _unknown;
+    std::unordered_map<beam::Asset::ID, beam::Height> _requested;    // the height the info was asked at
+
+    std::unordered_map<beam::Asset::ID, beam::wallet::WalletAsset> _assets;
+    std::unordered_set<beam::Asset::ID> _cached;    // loaded from the file and not checked yet
+    QTimer _saveTimer;
+};
+
+// Per owner view of the AssetsRegistry, relays its assetInfo signal
 class AssetsManager: public QObject
 {
     Q_OBJECT
@@ -38,16 +100,6 @@ public:
 signals:
     void assetInfo(beam::Asset::ID assetId);
 
-private slots:
-    void onAssetInfo(beam::Asset::ID, const beam::wallet::WalletAsset&);
-
 private:
-    typedef std::unique_ptr<beam::wallet::WalletAssetMeta> MetaPtr;
-    MetaPtr getAsset(beam::Asset::ID);
-
-    WalletModel& _wallet;
-    std::map<beam::Asset::ID, beam::wallet::WalletAsset> _info;
-
-    std::map<int, QColor> _colors;
-    std::map<int, QString> _icons;
+    AssetsRegistry::Ptr _registry;
 };
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include "assets_view.h"
+#include "model/event_monitor.h"
 #include "model/app_model.h"
 
 namespace
@@ -22,7 +23,7 @@ namespace
 AssetsViewModel::AssetsViewModel()
     : _wallet (*AppModel::getInstance().getWallet())
 {
-    connect(&_wallet, &WalletModel::walletStatusChanged, this, &AssetsViewModel::onWalletStatus);
+    connect(&_wallet, &WalletModel::balancesChanged, this, &AssetsViewModel::onWalletStatus);
 
     auto assetBEAM  = std::make_shared<AssetObject>(0);
 
@@ -63,10 +64,20 @@ void AssetsViewModel::formAssetsList()
     }
 
     _assets.reset(all);
+    _assetIds = assets;
 }
 
 void AssetsViewModel::onWalletStatus()
 {
+    EventMonitor::Scope monitorScope("AssetsViewModel::onWalletStatus");
+
+    // balances of the listed assets are refreshed by the list itself,
+    // it is rebuilt only when assets appear or disappear
+    if (_wallet.getAssetsNZ() == _assetIds)
+    {
+        return;
+    }
+
     formAssetsList();
     emit assetsChanged();
 }
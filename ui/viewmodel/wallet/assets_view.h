@@ -43,4 +43,5 @@ private:
     bool         _folded;
     AssetsList   _assets;
     WalletModel& _wallet;
+    std::vector<beam::Asset::ID> _assetIds;
 };
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include "info_view.h"
+#include "model/event_monitor.h"
 #include "model/app_model.h"
 
 namespace {
@@ -24,7 +25,7 @@ InfoViewModel::InfoViewModel()
     : _wallet(*AppModel::getInstance().getWallet())
     , _selectedAssetID(-1)
 {
-    connect(&_wallet,  &WalletModel::walletStatusChanged,        this,  &InfoViewModel::onWalletStatus);
+    connect(&_wallet,  &WalletModel::balancesChanged,            this,  &InfoViewModel::onWalletStatus);
     connect(&_amgr,    &AssetsManager::assetInfo,                this,  &InfoViewModel::onAssetInfo);
     connect(&_ermgr,   &ExchangeRatesManager::rateUnitChanged,   this,  &InfoViewModel::assetChanged);
     connect(&_ermgr,   &ExchangeRatesManager::activeRateChanged, this,  &InfoViewModel::assetChanged);
@@ -100,6 +101,8 @@ void InfoViewModel::setSelectedAsset(int newAsset)
 
 void InfoViewModel::onWalletStatus()
 {
+    EventMonitor::Scope monitorScope("InfoViewModel::onWalletStatus");
+
     updateProgress();
     emit assetChanged();
 }
@@ -0,0 +1,183 @@
+// Copyright 2020 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tx_filter_proxy.h"
+
+TxFilterProxyModel::TxFilterProxyModel(QObject* parent)
+    : SortFilterProxyModel(parent)
+{
+    m_searchTimer.setSingleShot(true);
+    connect(&m_searchTimer, &QTimer::timeout, this, [this] ()
+    {
+        m_filter.search = m_searchText.toCaseFolded();
+        applyPredicates();
+    });
+}
+
+QList<int> TxFilterProxyModel::statuses() const
+{
+    QList<int> statuses;
+    for (auto status : m_filter.statuses)
+    {
+        statuses.push_back(static_cast<int>(status));
+    }
+    return statuses;
+}
+
+void TxFilterProxyModel::setStatuses(const QList<int>& statuses)
+{
+    m_filter.statuses.clear();
+    for (auto status : statuses)
+    {
+        m_filter.statuses.push_back(static_cast<beam::wallet::TxStatus>(status));
+    }
+    applyPredicates();
+}
+
+TxFilterProxyModel::Direction TxFilterProxyModel::direction() const
+{
+    switch (m_filter.direction)
+    {
+    case TxObjectList::Filter::Direction::Incoming:
+        return Incoming;
+    case TxObjectList::Filter::Direction::Outgoing:
+        return Outgoing;
+    default:
+        return AnyDirection;
+    }
+}
+
+void TxFilterProxyModel::setDirection(Direction direction)
+{
+    switch (direction)
+    {
+    case Incoming:
+        m_filter.direction = TxObjectList::Filter::Direction::Incoming;
+        break;
+    case Outgoing:
+        m_filter.direction = TxObjectList::Filter::Direction::Outgoing;
+        break;
+    default:
+        m_filter.direction = TxObjectList::Filter::Direction::Any;
+        break;
+    }
+    applyPredicates();
+}
+
+int TxFilterProxyModel::assetId() const
+{
+    return m_filter.assetId;
+}
+
+void TxFilterProxyModel::setAssetId(int assetId)
+{
+    if (m_filter.assetId != assetId)
+    {
+        m_filter.assetId = assetId;
+        applyPredicates();
+    }
+}
+
+bool TxFilterProxyModel::shieldedOnly() const
+{
+    return m_filter.shieldedOnly;
+}
+
+void TxFilterProxyModel::setShieldedOnly(bool value)
+{
+    if (m_filter.shieldedOnly != value)
+    {
+        m_filter.shieldedOnly = value;
+        applyPredicates();
+    }
+}
+
+bool TxFilterProxyModel::offlineOnly() const
+{
+    return m_filter.offlineOnly;
+}
+
+void TxFilterProxyModel::setOfflineOnly(bool value)
+{
+    if (m_filter.offlineOnly != value)
+    {
+        m_filter.offlineOnly = value;
+        applyPredicates();
+    }
+}
+
+QDateTime TxFilterProxyModel::createdFrom() const
+{
+    return m_filter.createdFrom ? QDateTime::fromSecsSinceEpoch(m_filter.createdFrom) : QDateTime();
+}
+
+void TxFilterProxyModel::setCreatedFrom(const QDateTime& time)
+{
+    m_filter.createdFrom = time.isValid() ? beam::Timestamp(time.toSecsSinceEpoch()) : 0;
+    applyPredicates();
+}
+
+QDateTime TxFilterProxyModel::createdTo() const
+{
+    return m_filter.createdTo ? QDateTime::fromSecsSinceEpoch(m_filter.createdTo) : QDateTime();
+}
+
+void TxFilterProxyModel::setCreatedTo(const QDateTime& time)
+{
+    m_filter.createdTo = time.isValid() ? beam::Timestamp(time.toSecsSinceEpoch()) : 0;
+    applyPredicates();
+}
+
+QString TxFilterProxyModel::searchText() const
+{
+    return m_searchText;
+}
+
+void TxFilterProxyModel::setSearchText(const QString& text)
+{
+    if (m_searchText != text)
+    {
+        m_searchText = text;
+        m_searchTimer.start(filterDelay());
+    }
+}
+
+bool TxFilterProxyModel::isSelectionApplied() const
+{
+    return !m_selectPending && !m_searchTimer.isActive();
+}
+
+void TxFilterProxyModel::componentComplete()
+{
+    SortFilterProxyModel::componentComplete();
+    applyPredicates();
+}
+
+void TxFilterProxyModel::applyPredicates()
+{
+    // a tab switch sets several predicates in a row, the list selects its rows once for all of them
+    if (m_selectPending)
+    {
+        return;
+    }
+    m_selectPending = true;
+    QMetaObject::invokeMethod(this, [this] ()
+    {
+        m_selectPending = false;
+        if (auto* list = qobject_cast<TxObjectList*>(sourceModel()))
+        {
+            list->select(m_filter);
+        }
+    }, Qt::QueuedConnection);
+}
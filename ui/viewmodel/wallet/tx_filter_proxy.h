@@ -0,0 +1,90 @@
+// Copyright 2020 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QDateTime>
+#include <QTimer>
+#include "viewmodel/helpers/sortfilterproxymodel.h"
+#include "tx_object_list.h"
+
+// Transactions proxy with typed predicates and a text search, sorted by SortFilterProxyModel.
+// The predicates are not checked per row: TxObjectList selects the matching transactions
+// through its status, asset, direction and search indexes and creates rows only for them
+class TxFilterProxyModel : public SortFilterProxyModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QList<int> statuses         READ statuses      WRITE setStatuses)
+    Q_PROPERTY(Direction direction         READ direction     WRITE setDirection)
+    Q_PROPERTY(int       assetId           READ assetId       WRITE setAssetId)
+    Q_PROPERTY(bool      shieldedOnly      READ shieldedOnly  WRITE setShieldedOnly)
+    Q_PROPERTY(bool      offlineOnly       READ offlineOnly   WRITE setOfflineOnly)
+    Q_PROPERTY(QDateTime createdFrom       READ createdFrom   WRITE setCreatedFrom)
+    Q_PROPERTY(QDateTime createdTo         READ createdTo     WRITE setCreatedTo)
+    Q_PROPERTY(QString   searchText        READ searchText    WRITE setSearchText)
+
+public:
+    enum Direction
+    {
+        AnyDirection,
+        Incoming,
+        Outgoing
+    };
+    Q_ENUM(Direction)
+
+    // mirrors beam::wallet::TxStatus for the statuses property
+    enum Status
+    {
+        Pending = static_cast<int>(beam::wallet::TxStatus::Pending),
+        InProgress = static_cast<int>(beam::wallet::TxStatus::InProgress),
+        Canceled = static_cast<int>(beam::wallet::TxStatus::Canceled),
+        Completed = static_cast<int>(beam::wallet::TxStatus::Completed),
+        Failed = static_cast<int>(beam::wallet::TxStatus::Failed),
+        Registering = static_cast<int>(beam::wallet::TxStatus::Registering)
+    };
+    Q_ENUM(Status)
+
+    explicit TxFilterProxyModel(QObject* parent = nullptr);
+
+    QList<int> statuses() const;
+    void setStatuses(const QList<int>& statuses);
+    Direction direction() const;
+    void setDirection(Direction direction);
+    int assetId() const;
+    void setAssetId(int assetId);
+    bool shieldedOnly() const;
+    void setShieldedOnly(bool value);
+    bool offlineOnly() const;
+    void setOfflineOnly(bool value);
+    QDateTime createdFrom() const;
+    void setCreatedFrom(const QDateTime& time);
+    QDateTime createdTo() const;
+    void setCreatedTo(const QDateTime& time);
+    // applied after filterDelay, case insensitive substring of ids, addresses, token and comment
+    QString searchText() const;
+    void setSearchText(const QString& text);
+    // the rows are selected by the current predicates, no search delay or selection is pending
+    bool isSelectionApplied() const;
+
+    void componentComplete() override;
+
+private:
+    void applyPredicates();
+
+    TxObjectList::Filter m_filter;
+    QString m_searchText;
+    QTimer m_searchTimer;
+    bool m_selectPending = false;
+};
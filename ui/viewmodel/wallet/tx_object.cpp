@@ -17,6 +17,7 @@
 #include "wallet/core/simple_transaction.h"
 #include "wallet/core/strings_resources.h"
 #include "model/app_model.h"
+#include <QStringList>
 
 using namespace beam;
 using namespace beam::wallet;
@@ -24,10 +25,8 @@ using namespace beamui;
 
 namespace
 {
-    QString getWaitingPeerStr(const beam::wallet::TxParameters& txParameters, bool isSender)
+    QString getWaitingPeerStr(const boost::optional<Height>& minHeight, const boost::optional<Height>& responseTime, bool isSender)
     {
-        auto minHeight = txParameters.GetParameter<beam::Height>(TxParameterID::MinHeight);
-        auto responseTime = txParameters.GetParameter<beam::Height>(TxParameterID::PeerResponseTime);
         QString time = "";
         if (minHeight && responseTime)
         {
@@ -42,10 +41,9 @@ namespace
         return qtTrId("tx-state-initial-receiver").arg(time);
     }
 
-    QString getInProgressStr(const beam::wallet::TxParameters& txParameters)
+    QString getInProgressStr(const boost::optional<Height>& maxHeight, const boost::optional<Height>& lifetime)
     {
         const Height kNormalTxConfirmationDelay = 10;
-        auto maxHeight = txParameters.GetParameter<beam::Height>(TxParameterID::MaxHeight);
         QString time = "";
         if (!maxHeight)
         {
@@ -59,7 +57,6 @@ namespace
         }
 
         Height delta =  *maxHeight - currentHeight;
-        auto lifetime = txParameters.GetParameter<beam::Height>(TxParameterID::Lifetime);
         if (!lifetime || *lifetime < delta)
         {
             return "";
@@ -79,25 +76,229 @@ namespace
         //% "It is taking longer than usual. In case the transaction could not be completed it will be canceled automatically in %1."
         return qtTrId("tx-state-in-progress-long").arg(time);
     }
+
+    std::string interpretStatus(const TxDescription& tx)
+    {
+        if (tx.m_txType == wallet::TxType::Simple)
+        {
+            SimpleTxStatusInterpreter interpreter(tx);
+            return interpreter.getStatus();
+        }
+        else if (tx.m_txType == wallet::TxType::PushTransaction)
+        {
+            MaxPrivacyTxStatusInterpreter interpreter(tx);
+            return interpreter.getStatus();
+        }
+        else if (tx.m_txType >= wallet::TxType::AssetIssue && tx.m_txType <= wallet::TxType::AssetInfo)
+        {
+            AssetTxStatusInterpreter interpreter(tx);
+            return interpreter.getStatus();
+        }
+        // other types provide their own status
+        return "unknown";
+    }
+
+    using DisplayStatus = TxObject::DisplayStatus;
+
+    DisplayStatus selectShieldedStatus(TxAddressType addressType
+        , DisplayStatus maxPrivacy
+        , DisplayStatus offline
+        , DisplayStatus publicOffline
+        , DisplayStatus fallback)
+    {
+        switch (addressType)
+        {
+        case TxAddressType::MaxPrivacy:
+            return maxPrivacy;
+        case TxAddressType::Offline:
+            return offline;
+        case TxAddressType::PublicOffline:
+            return publicOffline;
+        default:
+            return fallback;
+        }
+    }
+
+    DisplayStatus foldStatus(const TxDescription& tx, TxAddressType addressType)
+    {
+        static const std::map<std::string, DisplayStatus> simple =
+        {
+            { "pending", DisplayStatus::Pending },
+            { "waiting for sender", DisplayStatus::WaitingSender },
+            { "waiting for receiver", DisplayStatus::WaitingReceiver },
+            { "in progress", DisplayStatus::InProgress },
+            { "sent to own address", DisplayStatus::SentToOwn },
+            { "sending to own address", DisplayStatus::SendingToOwn },
+            { "received", DisplayStatus::Received },
+            { "sent", DisplayStatus::Sent },
+            { "cancelled", DisplayStatus::Cancelled },
+            { "expired", DisplayStatus::Expired },
+            { "failed", DisplayStatus::Failed }
+        };
+
+        const auto status = interpretStatus(tx);
+        if (auto it = simple.find(status); it != simple.end())
+        {
+            return it->second;
+        }
+        if (status == "in progress max privacy")
+        {
+            return selectShieldedStatus(addressType, DisplayStatus::InProgressMaxPrivacy, DisplayStatus::InProgressOffline,
+                                        DisplayStatus::InProgressPublicOffline, DisplayStatus::InProgress);
+        }
+        if (status == "sent max privacy")
+        {
+            return selectShieldedStatus(addressType, DisplayStatus::SentMaxPrivacy, DisplayStatus::SentOffline,
+                                        DisplayStatus::SentPublicOffline, DisplayStatus::Sent);
+        }
+        if (status == "received max privacy")
+        {
+            return selectShieldedStatus(addressType, DisplayStatus::ReceivedMaxPrivacy, DisplayStatus::ReceivedOffline,
+                                        DisplayStatus::ReceivedPublicOffline, DisplayStatus::Received);
+        }
+        if (status == "canceled max privacy")
+        {
+            return selectShieldedStatus(addressType, DisplayStatus::CancelledMaxPrivacy, DisplayStatus::CancelledOffline,
+                                        DisplayStatus::CancelledPublicOffline, DisplayStatus::Cancelled);
+        }
+        if (status == "failed max privacy")
+        {
+            return selectShieldedStatus(addressType, DisplayStatus::FailedMaxPrivacy, DisplayStatus::FailedOffline,
+                                        DisplayStatus::FailedPublicOffline, DisplayStatus::Failed);
+        }
+        return DisplayStatus::Unknown;
+    }
+
+    boost::optional<Amount> findRate(const TxDescription& tx, ExchangeRate::Currency secondCurrency)
+    {
+        if (tx.m_assetId != Asset::s_BeamID)
+        {
+            return boost::none;
+        }
+
+        auto exchangeRatesOptional = tx.GetParameter<std::vector<ExchangeRate>>(TxParameterID::ExchangeRates);
+        if (exchangeRatesOptional)
+        {
+            std::vector<ExchangeRate>& rates = *exchangeRatesOptional;
+            auto search = std::find_if(std::begin(rates),
+                                       std::end(rates),
+                                       [secondCurrency](const ExchangeRate& r)
+                                       {
+                                           return r.m_currency == ExchangeRate::Currency::Beam
+                                               && r.m_unit == secondCurrency;
+                                       });
+            if (search != std::cend(rates))
+            {
+                return search->m_rate;
+            }
+        }
+        return boost::none;
+    }
+
+    TxAddressType restoreAddressType(const TxDescription& tx)
+    {
+        auto storedType = tx.GetParameter<TxAddressType>(TxParameterID::AddressType);
+        if (storedType)
+        {
+            return *storedType;
+        }
+
+        if (!tx.m_sender)
+        {
+            return TxAddressType::Unknown;
+        }
+
+        return GetAddressType(tx);
+    }
+
+    QString addressFromOf(const TxDescription& tx, const QString& senderIdentity)
+    {
+        if (tx.m_txType == wallet::TxType::PushTransaction && !tx.m_sender)
+        {
+            return senderIdentity;
+        }
+        return toString(tx.m_sender ? tx.m_myId : tx.m_peerId);
+    }
+
+    QString addressToOf(const TxDescription& tx, const QString& token)
+    {
+        if (tx.m_sender)
+        {
+            return token.isEmpty() ? toString(tx.m_peerId) : token;
+        }
+        return toString(tx.m_myId);
+    }
+
+    QString commentOf(const TxDescription& tx)
+    {
+        std::string comment{ tx.m_message.begin(), tx.m_message.end() };
+        return QString(comment.c_str()).trimmed();
+    }
 }
 
 
-TxObject::TxObject( const TxDescription& tx,
-                    QObject* parent/* = nullptr*/)
-        : TxObject(tx, beam::wallet::ExchangeRate::Currency::Unknown, parent)
+TxObject::TxObject(const TxDescription& tx)
+        : TxObject(tx, beam::wallet::ExchangeRate::Currency::Unknown)
 {
 }
 
-TxObject::TxObject( const TxDescription& tx,
-                    beam::wallet::ExchangeRate::Currency secondCurrency,
-                    QObject* parent/* = nullptr*/)
-        : QObject(parent)
-        , m_tx(tx)
-        , m_type(*m_tx.GetParameter<TxType>(TxParameterID::TransactionType))
-        , m_secondCurrency(secondCurrency)
+TxAddressType TxObject::addressTypeOf(const TxDescription& tx)
 {
-    auto kernelID = QString::fromStdString(to_hex(m_tx.m_kernelID.m_pData, m_tx.m_kernelID.nBytes));
-    setKernelID(kernelID);
+    return restoreAddressType(tx);
+}
+
+QString TxObject::searchTextOf(const TxDescription& tx)
+{
+    const auto token = QString::fromStdString(tx.getToken());
+    const auto senderIdentity = QString::fromStdString(tx.getSenderIdentity());
+    const auto receiverIdentity = QString::fromStdString(tx.getReceiverIdentity());
+    return QStringList
+    {
+        QString::fromStdString(to_hex(tx.m_txId.data(), tx.m_txId.size())),
+        QString::fromStdString(to_hex(tx.m_kernelID.m_pData, tx.m_kernelID.nBytes)),
+        addressFromOf(tx, senderIdentity),
+        addressToOf(tx, token),
+        commentOf(tx),
+        senderIdentity,
+        receiverIdentity,
+        token
+    }.join(' ');
+}
+
+TxObject::TxObject(const TxDescription& tx,
+                   beam::wallet::ExchangeRate::Currency secondCurrency)
+        : m_txId(tx.m_txId)
+        , m_createTime(tx.m_createTime)
+        , m_amount(tx.m_amount)
+        , m_fee(tx.m_fee)
+        , m_shieldedFee(tx.m_fee ? GetShieldedFee(tx) : 0)
+        , m_assetId(tx.m_assetId)
+        , m_status(tx.m_status)
+        , m_failureReason(tx.m_failureReason)
+        , m_type(*tx.GetParameter<TxType>(TxParameterID::TransactionType))
+        , m_addressType(restoreAddressType(tx))
+        , m_sender(tx.m_sender)
+        , m_selfTx(tx.m_selfTx)
+        , m_canCancel(tx.canCancel())
+        , m_canDelete(tx.canDelete())
+        , m_kernelID(QString::fromStdString(to_hex(tx.m_kernelID.m_pData, tx.m_kernelID.nBytes)))
+        , m_token(QString::fromStdString(tx.getToken()))
+        , m_senderIdentity(QString::fromStdString(tx.getSenderIdentity()))
+        , m_receiverIdentity(QString::fromStdString(tx.getReceiverIdentity()))
+        , m_displayStatus(foldStatus(tx, m_addressType))
+        , m_rate(findRate(tx, secondCurrency))
+{
+    m_comment = commentOf(tx);
+    m_addressFrom = addressFromOf(tx, m_senderIdentity);
+    m_addressTo = addressToOf(tx, m_token);
+
+    if (m_status == TxStatus::Pending || m_status == TxStatus::InProgress || m_status == TxStatus::Registering)
+    {
+        m_minHeight = tx.GetParameter<Height>(TxParameterID::MinHeight);
+        m_responseTime = tx.GetParameter<Height>(TxParameterID::PeerResponseTime);
+        m_maxHeight = tx.GetParameter<Height>(TxParameterID::MaxHeight);
+        m_lifetime = tx.GetParameter<Height>(TxParameterID::Lifetime);
+    }
 }
 
 bool TxObject::operator==(const TxObject& other) const
@@ -105,162 +306,128 @@ bool TxObject::operator==(const TxObject& other) const
     return getTxID() == other.getTxID();
 }
 
+uint32_t TxObject::compare(const TxObject& other) const
+{
+    uint32_t changes = NoChanges;
+    if (m_status != other.m_status)
+    {
+        changes |= StatusChanged;
+    }
+    if (m_kernelID != other.m_kernelID)
+    {
+        changes |= KernelChanged;
+    }
+    if (m_failureReason != other.m_failureReason)
+    {
+        changes |= FailureChanged;
+    }
+    if (m_fee != other.m_fee || m_shieldedFee != other.m_shieldedFee)
+    {
+        changes |= FeeChanged;
+    }
+    if (m_addressFrom != other.m_addressFrom || m_addressTo != other.m_addressTo
+        || m_addressType != other.m_addressType || m_token != other.m_token
+        || m_senderIdentity != other.m_senderIdentity || m_receiverIdentity != other.m_receiverIdentity)
+    {
+        changes |= AddressChanged;
+    }
+    if (m_displayStatus != other.m_displayStatus)
+    {
+        changes |= StatusChanged;
+    }
+    if (m_minHeight != other.m_minHeight || m_maxHeight != other.m_maxHeight
+        || m_responseTime != other.m_responseTime || m_lifetime != other.m_lifetime)
+    {
+        changes |= StateChanged;
+    }
+    if (m_amount != other.m_amount || m_rate != other.m_rate)
+    {
+        changes |= AmountChanged;
+    }
+    if (m_comment != other.m_comment)
+    {
+        changes |= CommentChanged;
+    }
+    return changes;
+}
+
 auto TxObject::timeCreated() const -> beam::Timestamp
 {
-    return m_tx.m_createTime;
+    return m_createTime;
 }
 
 auto TxObject::getTxID() const -> beam::wallet::TxID
 {
-    return m_tx.m_txId;
+    return m_txId;
 }
 
 bool TxObject::isIncome() const
 {
-    return m_tx.m_sender == false;
+    return m_sender == false;
 }
 
 QString TxObject::getComment() const
 {
-    std::string str{ m_tx.m_message.begin(), m_tx.m_message.end() };
-    return QString(str.c_str()).trimmed();
+    return m_comment;
 }
 
 QString TxObject::getAmount() const
 {
-    return AmountToUIString(m_tx.m_amount);
+    return AmountToUIString(m_amount);
 }
 
 beam::Amount TxObject::getAmountValue() const
 {
-    return m_tx.m_amount;
+    return m_amount;
 }
 
 QString TxObject::getRate() const
 {
-    if (m_tx.m_assetId != Asset::s_BeamID)
-    {
-        return "0";
-    }
-
-    auto exchangeRatesOptional = getTxDescription().GetParameter<std::vector<ExchangeRate>>(TxParameterID::ExchangeRates);
-    if (exchangeRatesOptional)
-    {
-        std::vector<ExchangeRate>& rates = *exchangeRatesOptional;
-        auto secondCurrency = m_secondCurrency;
-        auto search = std::find_if(std::begin(rates),
-                                   std::end(rates),
-                                   [secondCurrency](const ExchangeRate& r)
-                                   {
-                                       return r.m_currency == ExchangeRate::Currency::Beam
-                                           && r.m_unit == secondCurrency;
-                                   });
-        if (search != std::cend(rates))
-        {
-            return AmountToUIString(search->m_rate);
-        }
-    }
-
-    return "0";
+    return m_rate ? AmountToUIString(*m_rate) : "0";
 }
 
-QString TxObject::getStatus() const
+TxObject::DisplayStatus TxObject::getDisplayStatus() const
 {
-    if (m_tx.m_txType == wallet::TxType::Simple)
-    {
-        SimpleTxStatusInterpreter interpreter(m_tx);
-        return interpreter.getStatus().c_str();
-    }
-    else if (m_tx.m_txType == wallet::TxType::PushTransaction)
-    {
-        MaxPrivacyTxStatusInterpreter interpreter(m_tx);
-        return interpreter.getStatus().c_str();
-    }
-    else if (m_tx.m_txType >= wallet::TxType::AssetIssue && m_tx.m_txType <= wallet::TxType::AssetInfo)
-    {
-        AssetTxStatusInterpreter interpreter(m_tx);
-        return interpreter.getStatus().c_str();
-    }
-    else
-    {
-        BOOST_ASSERT_MSG(false, kErrorUnknownTxType);
-        return "unknown";
-    }
+    return m_displayStatus;
 }
 
 bool TxObject::isCancelAvailable() const
 {
-    return m_tx.canCancel();
+    return m_canCancel;
 }
 
 bool TxObject::isDeleteAvailable() const
 {
-    return m_tx.canDelete();
+    return m_canDelete;
 }
 
 QString TxObject::getAddressFrom() const
 {
-    if (m_tx.m_txType == wallet::TxType::PushTransaction && !m_tx.m_sender)
-    {
-        return getSenderIdentity();
-    }
-    return toString(m_tx.m_sender ? m_tx.m_myId : m_tx.m_peerId);
+    return m_addressFrom;
 }
 
 QString TxObject::getAddressTo() const
 {
-    if (m_tx.m_sender)
-    {
-        auto token = getToken();
-        if (token.isEmpty())
-            return toString(m_tx.m_peerId);
-
-        return token;
-    }
-    return toString(m_tx.m_myId);
+    return m_addressTo;
 }
 
 QString TxObject::getFee() const
 {
-    if (m_tx.m_fee)
+    if (m_fee)
     {
-        Amount shieldedFee = GetShieldedFee(m_tx);
-        return AmountInGrothToUIString(shieldedFee + m_tx.m_fee);
+        return AmountInGrothToUIString(m_shieldedFee + m_fee);
     }
     return QString{};
 }
 
-const beam::wallet::TxDescription& TxObject::getTxDescription() const
-{
-    return m_tx;
-}
-
-void TxObject::setStatus(beam::wallet::TxStatus status)
-{
-    if (m_tx.m_status != status)
-    {
-        m_tx.m_status = status;
-        emit statusChanged();
-    }
-}
-
 QString TxObject::getKernelID() const
 {
     return m_kernelID;
 }
 
-void TxObject::setKernelID(const QString& value)
-{
-    if (m_kernelID != value)
-    {
-        m_kernelID = value;
-        emit kernelIDChanged();
-    }
-}
-
 QString TxObject::getTransactionID() const
 {
-    return QString::fromStdString(to_hex(m_tx.m_txId.data(), m_tx.m_txId.size()));
+    return QString::fromStdString(to_hex(m_txId.data(), m_txId.size()));
 }
 
 QString TxObject::getReasonString(beam::wallet::TxFailureReason reason) const
@@ -391,56 +558,32 @@ QString TxObject::getReasonString(beam::wallet::TxFailureReason reason) const
 
 QString TxObject::getFailureReason() const
 {
-    if (getTxDescription().m_status == wallet::TxStatus::Failed)
+    if (m_status == wallet::TxStatus::Failed)
     {
-        return getReasonString(getTxDescription().m_failureReason);
+        return getReasonString(m_failureReason);
     }
 
     return QString();
 }
 
-void TxObject::setFailureReason(beam::wallet::TxFailureReason reason)
-{
-    if (m_tx.m_failureReason != reason)
-    {
-        m_tx.m_failureReason = reason;
-        emit failureReasonChanged();
-    }
-}
-
 QString TxObject::getStateDetails() const
 {
-    auto& tx = getTxDescription();
-    if (tx.m_txType == beam::wallet::TxType::Simple)
+    if (m_type == beam::wallet::TxType::Simple)
     {
-        switch (tx.m_status)
+        switch (m_status)
         {
         case beam::wallet::TxStatus::Pending:
         case beam::wallet::TxStatus::InProgress:
-        {
-            auto state = tx.GetParameter<wallet::SimpleTransaction::State>(TxParameterID::State);
-            if (state)
-            {
-                switch (*state)
-                {
-                case wallet::SimpleTransaction::Initial:
-                case wallet::SimpleTransaction::Invitation:
-                    return getWaitingPeerStr(tx, tx.m_sender);
-                default:
-                    break;
-                }
-            }
-            return getWaitingPeerStr(tx, tx.m_sender);
-        }
+            return getWaitingPeerStr(m_minHeight, m_responseTime, m_sender);
         case beam::wallet::TxStatus::Registering:
-            return getInProgressStr(tx);
+            return getInProgressStr(m_maxHeight, m_lifetime);
         default:
             break;
         }
     }
 
-    if (tx.m_txType == beam::wallet::TxType::PushTransaction &&
-        (tx.m_status == beam::wallet::TxStatus::InProgress || tx.m_status == beam::wallet::TxStatus::Registering))
+    if (m_type == beam::wallet::TxType::PushTransaction &&
+        (m_status == beam::wallet::TxStatus::InProgress || m_status == beam::wallet::TxStatus::Registering))
     {
         //% "The transaction is usually expected to complete in a few minutes."
         return qtTrId("tx-state-in-progress-normal");
@@ -448,44 +591,43 @@ QString TxObject::getStateDetails() const
     return "";
 }
 
+bool TxObject::isHeightDependent() const
+{
+    return m_type == beam::wallet::TxType::Simple
+        && (m_status == beam::wallet::TxStatus::Pending
+            || m_status == beam::wallet::TxStatus::InProgress
+            || m_status == beam::wallet::TxStatus::Registering);
+}
+
 QString TxObject::getToken() const
 {
-    const auto& tx = getTxDescription();
-    return QString::fromStdString(tx.getToken());
+    return m_token;
 }
 
 QString TxObject::getSenderIdentity() const
 {
-    return QString::fromStdString(m_tx.getSenderIdentity());
+    return m_senderIdentity;
 }
 
 QString TxObject::getReceiverIdentity() const
 {
-    return QString::fromStdString(m_tx.getReceiverIdentity());
+    return m_receiverIdentity;
 }
 
 beam::Asset::ID TxObject::getAssetId() const
 {
-    return m_tx.m_assetId;
+    return m_assetId;
 }
 
 bool TxObject::hasPaymentProof() const
 {
-    return !isIncome() && m_tx.m_status == wallet::TxStatus::Completed 
-        && (m_tx.m_txType == TxType::Simple || m_tx.m_txType == TxType::PushTransaction);
-}
-
-void TxObject::update(const beam::wallet::TxDescription& tx)
-{
-    setStatus(tx.m_status);
-    auto kernelID = QString::fromStdString(to_hex(tx.m_kernelID.m_pData, tx.m_kernelID.nBytes));
-    setKernelID(kernelID);
-    setFailureReason(tx.m_failureReason);
+    return !isIncome() && m_status == wallet::TxStatus::Completed 
+        && (m_type == TxType::Simple || m_type == TxType::PushTransaction);
 }
 
 bool TxObject::isInProgress() const
 {
-    switch (m_tx.m_status)
+    switch (m_status)
     {
         case wallet::TxStatus::Pending:
         case wallet::TxStatus::InProgress:
@@ -496,34 +638,34 @@ bool TxObject::isInProgress() const
     }
 }
 
+beam::wallet::TxStatus TxObject::getTxStatus() const
+{
+    return m_status;
+}
+
 bool TxObject::isPending() const
 {
-    return m_tx.m_status == wallet::TxStatus::Pending;
+    return m_status == wallet::TxStatus::Pending;
 }
 
 bool TxObject::isCompleted() const
 {
-    return m_tx.m_status == wallet::TxStatus::Completed;
+    return m_status == wallet::TxStatus::Completed;
 }
 
 bool TxObject::isSelfTx() const
 {
-    return m_tx.m_selfTx;
+    return m_selfTx;
 }
 
 bool TxObject::isShieldedTx() const
 {
-    return m_tx.m_txType == TxType::PushTransaction;
+    return m_type == TxType::PushTransaction;
 }
 
-beam::wallet::TxAddressType TxObject::getAddressType()
+beam::wallet::TxAddressType TxObject::getAddressType() const
 {
-    restoreAddressType();
-
-    if (m_addressType)
-        return *m_addressType;
-
-    return TxAddressType::Unknown;
+    return m_addressType;
 }
 
 bool TxObject::isSent() const
@@ -538,30 +680,15 @@ bool TxObject::isReceived() const
 
 bool TxObject::isCanceled() const
 {
-    return m_tx.m_status == wallet::TxStatus::Canceled;
+    return m_status == wallet::TxStatus::Canceled;
 }
 
 bool TxObject::isFailed() const
 {
-    return m_tx.m_status == wallet::TxStatus::Failed;
+    return m_status == wallet::TxStatus::Failed;
 }
 
 bool TxObject::isExpired() const
 {
-    return isFailed() && m_tx.m_failureReason == TxFailureReason::TransactionExpired;
-}
-
-void TxObject::restoreAddressType()
-{
-    auto storedType = m_tx.GetParameter<TxAddressType>(TxParameterID::AddressType);
-    if (storedType)
-    {
-        m_addressType = storedType;
-        return;
-    }
-
-    if (!m_tx.m_sender || m_addressType)
-        return;
-
-    m_addressType = GetAddressType(m_tx);
+    return isFailed() && m_failureReason == TxFailureReason::TransactionExpired;
 }
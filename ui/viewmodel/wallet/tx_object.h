@@ -13,23 +13,75 @@
 // limitations under the License.
 #pragma once
 
-#include <QObject>
 #include <QDateTime>
 #include "viewmodel/payment_item.h"
 #include "viewmodel/ui_helpers.h"
 #include "wallet/client/extensions/news_channels/interface.h"
 
-class TxObject : public QObject
+// Compact row of the transactions table. Only the fields and parameters
+// the table roles read are kept, decoded once when the row is created
+class TxObject
 {
-    Q_OBJECT
-
 public:
+    // Properties which differ between two snapshots of the same transaction
+    enum Changes : uint32_t
+    {
+        NoChanges      = 0,
+        StatusChanged  = 1 << 0,
+        KernelChanged  = 1 << 1,
+        FailureChanged = 1 << 2,
+        FeeChanged     = 1 << 3,
+        AddressChanged = 1 << 4,
+        StateChanged   = 1 << 5,   // heights and times behind the state details
+        AmountChanged  = 1 << 6,
+        CommentChanged = 1 << 7,
+        SwapChanged    = 1 << 8
+    };
+
+    // Status shown in the table, folded from the status interpreters and the address type.
+    // Declared in the order the status column sorts
+    enum class DisplayStatus : uint8_t
+    {
+        Pending,
+        WaitingSender,
+        WaitingReceiver,
+        InProgress,
+        InProgressMaxPrivacy,
+        InProgressOffline,
+        InProgressPublicOffline,
+        SendingToOwn,
+        SentToOwn,
+        Sent,
+        SentMaxPrivacy,
+        SentOffline,
+        SentPublicOffline,
+        Received,
+        ReceivedMaxPrivacy,
+        ReceivedOffline,
+        ReceivedPublicOffline,
+        Cancelled,
+        CancelledMaxPrivacy,
+        CancelledOffline,
+        CancelledPublicOffline,
+        Expired,
+        Failed,
+        FailedMaxPrivacy,
+        FailedOffline,
+        FailedPublicOffline,
+        Unknown,
+        Count
+    };
+
+    TxObject(const beam::wallet::TxDescription& tx);
     TxObject(const beam::wallet::TxDescription& tx,
-             QObject* parent = nullptr);
-    TxObject(const beam::wallet::TxDescription& tx,
-             beam::wallet::ExchangeRate::Currency secondCurrency,
-             QObject* parent = nullptr);
+             beam::wallet::ExchangeRate::Currency secondCurrency);
+    virtual ~TxObject() = default;
+    // the address type a row of the transaction shows, without creating the row
+    static beam::wallet::TxAddressType addressTypeOf(const beam::wallet::TxDescription& tx);
+    // ids, addresses, identities, token and comment which the transactions search looks through
+    static QString searchTextOf(const beam::wallet::TxDescription& tx);
     bool operator==(const TxObject& other) const;
+    uint32_t compare(const TxObject& other) const;
 
     beam::Timestamp timeCreated() const;
     beam::wallet::TxID getTxID() const;
@@ -43,18 +95,21 @@ public:
     QString getKernelID() const;
     QString getTransactionID() const ;
     bool hasPaymentProof() const;
-    virtual QString getStatus() const;
+    DisplayStatus getDisplayStatus() const;
     virtual QString getFailureReason() const;
     virtual QString getStateDetails() const;
+    // the state details count down to a height, so they change with every block
+    virtual bool isHeightDependent() const;
     QString getToken() const;
     QString getSenderIdentity() const;
     QString getReceiverIdentity() const;
     beam::Asset::ID getAssetId() const;
+    beam::wallet::TxStatus getTxStatus() const;
 
     bool isIncome() const;
     bool isSelfTx() const;
     bool isShieldedTx() const;
-    beam::wallet::TxAddressType getAddressType();
+    beam::wallet::TxAddressType getAddressType() const;
     bool isSent() const;
     bool isReceived() const;
     virtual bool isCancelAvailable() const;
@@ -66,26 +121,37 @@ public:
     virtual bool isCanceled() const;
     virtual bool isFailed() const;
 
-    void setKernelID(const QString& value);
-    void setStatus(beam::wallet::TxStatus status);
-    void setFailureReason(beam::wallet::TxFailureReason reason);
-    void update(const beam::wallet::TxDescription& tx);
-
-signals:
-    void statusChanged();
-    void kernelIDChanged();
-    void failureReasonChanged();
-
 protected:
-    const beam::wallet::TxDescription& getTxDescription() const;
     QString getReasonString(beam::wallet::TxFailureReason reason) const;
-    QString getIdentity(bool isSender) const;
-    void restoreAddressType();
- 
-    beam::wallet::TxDescription m_tx;
-    QString m_kernelID;
+
+    beam::wallet::TxID m_txId;
+    beam::Timestamp m_createTime;
+    beam::Amount m_amount;
+    beam::Amount m_fee;
+    beam::Amount m_shieldedFee;
+    beam::Asset::ID m_assetId;
+    beam::wallet::TxStatus m_status;
+    beam::wallet::TxFailureReason m_failureReason;
     beam::wallet::TxType m_type;
-    beam::wallet::ExchangeRate::Currency m_secondCurrency;
-    mutable  boost::optional<bool> m_hasVouchers;
-    boost::optional<beam::wallet::TxAddressType> m_addressType;
+    beam::wallet::TxAddressType m_addressType;
+    bool m_sender;
+    bool m_selfTx;
+    bool m_canCancel;
+    bool m_canDelete;
+
+    QString m_kernelID;
+    QString m_comment;
+    QString m_addressFrom;
+    QString m_addressTo;
+    QString m_token;
+    QString m_senderIdentity;
+    QString m_receiverIdentity;
+    DisplayStatus m_displayStatus;
+    boost::optional<beam::Amount> m_rate;
+
+    // parameters behind the state details of transactions in progress
+    boost::optional<beam::Height> m_minHeight;
+    boost::optional<beam::Height> m_responseTime;
+    boost::optional<beam::Height> m_maxHeight;
+    boost::optional<beam::Height> m_lifetime;
 };
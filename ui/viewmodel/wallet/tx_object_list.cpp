@@ -13,174 +13,127 @@
 // limitations under the License.
 
 #include "tx_object_list.h"
+#include "model/app_model.h"
 
 namespace
 {
     using namespace beam::wallet;
 
-    QString selectShilededStatus(TxAddressType addressType
-        , const QString& maxPrivacy
-        , const QString& offline
-        , const QString& publicOffline
-        , const QString& fallback)
-    {
-        switch (addressType)
-        {
-        case TxAddressType::MaxPrivacy:
-            return maxPrivacy;
-        case TxAddressType::Offline:
-            return offline;
-        case TxAddressType::PublicOffline:
-            return publicOffline;
-        default:
-            return fallback;
-        }
-    }
+    using DisplayStatus = TxObject::DisplayStatus;
 
-QString getStatusTextTranslated(const QString& status, TxAddressType addressType)
+// Labels of the status column indexed by TxObject::DisplayStatus, in the current language
+std::vector<QString> buildStatusTexts()
 {
-    if (status == "pending")
-    {
-        //% "pending"
-        return qtTrId("wallet-txs-status-pending");
-    }
-    else if (status == "waiting for sender")
-    {
-        //% "waiting for sender"
-        return qtTrId("wallet-txs-status-waiting-sender");
-    }
-    else if (status == "waiting for receiver")
-    {
-        //% "waiting for receiver"
-        return qtTrId("wallet-txs-status-waiting-receiver");
-    }
-    else if (status == "in progress")
-    {
-        //% "in progress"
-        return qtTrId("wallet-txs-status-in-progress");
-    }
-    else if (status == "sent to own address")
-    {
-        //% "sent to own address"
-        return qtTrId("wallet-txs-status-own-sent");
-    }
-    else if (status == "sending to own address")
+    std::vector<QString> texts(static_cast<size_t>(DisplayStatus::Count));
+    auto set = [&texts](DisplayStatus status, QString text)
     {
-        //% "sending to own address"
-        return qtTrId("wallet-txs-status-own-sending");
-    }
-    else if (status == "received")
-    {
-        //% "received"
-        return qtTrId("wallet-txs-status-received");
-    }
-    else if (status == "sent")
-    {
-        //% "sent"
-        return qtTrId("wallet-txs-status-sent");
-    }
-    else if (status == "cancelled")
-    {
-        //% "cancelled"
-        return qtTrId("wallet-txs-status-cancelled");
-    }
-    else if (status == "expired")
-    {
-        //% "expired"
-        return qtTrId("wallet-txs-status-expired");
-    }
-    else if (status == "failed")
-    {
-        //% "failed"
-        return qtTrId("wallet-txs-status-failed");
-    }
-    else if (status == "in progress max privacy")
-    {
-        return selectShilededStatus(addressType,
-        /*% "in progress
+        texts[static_cast<size_t>(status)] = std::move(text);
+    };
+
+    //% "pending"
+    set(DisplayStatus::Pending, qtTrId("wallet-txs-status-pending"));
+    //% "waiting for sender"
+    set(DisplayStatus::WaitingSender, qtTrId("wallet-txs-status-waiting-sender"));
+    //% "waiting for receiver"
+    set(DisplayStatus::WaitingReceiver, qtTrId("wallet-txs-status-waiting-receiver"));
+    //% "in progress"
+    set(DisplayStatus::InProgress, qtTrId("wallet-txs-status-in-progress"));
+    //% "sent to own address"
+    set(DisplayStatus::SentToOwn, qtTrId("wallet-txs-status-own-sent"));
+    //% "sending to own address"
+    set(DisplayStatus::SendingToOwn, qtTrId("wallet-txs-status-own-sending"));
+    //% "received"
+    set(DisplayStatus::Received, qtTrId("wallet-txs-status-received"));
+    //% "sent"
+    set(DisplayStatus::Sent, qtTrId("wallet-txs-status-sent"));
+    //% "cancelled"
+    set(DisplayStatus::Cancelled, qtTrId("wallet-txs-status-cancelled"));
+    //% "expired"
+    set(DisplayStatus::Expired, qtTrId("wallet-txs-status-expired"));
+    //% "failed"
+    set(DisplayStatus::Failed, qtTrId("wallet-txs-status-failed"));
+
+    /*% "in progress
 max privacy" */
-            qtTrId("wallet-txs-status-in-progress-max"),
-        /*% "in progress
+    set(DisplayStatus::InProgressMaxPrivacy, qtTrId("wallet-txs-status-in-progress-max"));
+    /*% "in progress
 offline" */
-            qtTrId("wallet-txs-status-in-progress-max-offline"),
-            /*% "in progress
+    set(DisplayStatus::InProgressOffline, qtTrId("wallet-txs-status-in-progress-max-offline"));
+    /*% "in progress
 public offline" */
-            qtTrId("wallet-txs-status-in-progress-public-offline"),
-            qtTrId("wallet-txs-status-in-progress")
-        );
-    }
-    else if (status == "sent max privacy")
-    {
-        return selectShilededStatus(addressType,
-        /*% "sent
+    set(DisplayStatus::InProgressPublicOffline, qtTrId("wallet-txs-status-in-progress-public-offline"));
+
+    /*% "sent
 max privacy"*/
-            qtTrId("wallet-txs-status-sent-max"),
-        /*% "sent
+    set(DisplayStatus::SentMaxPrivacy, qtTrId("wallet-txs-status-sent-max"));
+    /*% "sent
 offline"*/
-            qtTrId("wallet-txs-status-sent-max-offline"),
-            /*% "sent
+    set(DisplayStatus::SentOffline, qtTrId("wallet-txs-status-sent-max-offline"));
+    /*% "sent
 public offline" */
-            qtTrId("wallet-txs-status-sent-public-offline"),
-            qtTrId("wallet-txs-status-sent")
-        );
-    }
-    else if (status == "received max privacy")
-    {
-        return selectShilededStatus(addressType,
-        /*% "received
+    set(DisplayStatus::SentPublicOffline, qtTrId("wallet-txs-status-sent-public-offline"));
+
+    /*% "received
 max privacy" */
-            qtTrId("wallet-txs-status-received-max"),
-        /*% "received
+    set(DisplayStatus::ReceivedMaxPrivacy, qtTrId("wallet-txs-status-received-max"));
+    /*% "received
 offline" */
-            qtTrId("wallet-txs-status-received-max-offline"),
-            /*% "received
+    set(DisplayStatus::ReceivedOffline, qtTrId("wallet-txs-status-received-max-offline"));
+    /*% "received
 public offline" */
-            qtTrId("wallet-txs-status-received-public-offline"),
-            qtTrId("wallet-txs-status-received")
-        );
-    }
-    else if (status == "canceled max privacy")
-    {
-        return selectShilededStatus(addressType,
-        /*% "canceled
+    set(DisplayStatus::ReceivedPublicOffline, qtTrId("wallet-txs-status-received-public-offline"));
+
+    /*% "canceled
 max privacy" */
-            qtTrId("wallet-txs-canceled-max"),
-        /*% "canceled
+    set(DisplayStatus::CancelledMaxPrivacy, qtTrId("wallet-txs-canceled-max"));
+    /*% "canceled
 offline" */
-            qtTrId("wallet-txs-canceled-max-offline"),
-        /*% "canceled
+    set(DisplayStatus::CancelledOffline, qtTrId("wallet-txs-canceled-max-offline"));
+    /*% "canceled
 public offline" */
-            qtTrId("wallet-txs-status-canceled-public-offline"),
-            qtTrId("wallet-txs-status-cancelled")
-        );
-    }
-    else if (status == "failed max privacy")
-    {
-        return selectShilededStatus(addressType,
-            /*% "failed
+    set(DisplayStatus::CancelledPublicOffline, qtTrId("wallet-txs-status-canceled-public-offline"));
+
+    /*% "failed
 max privacy" */
-            qtTrId("wallet-txs-failed-max"),
-        /*% "failed
+    set(DisplayStatus::FailedMaxPrivacy, qtTrId("wallet-txs-failed-max"));
+    /*% "failed
 offline" */
-            qtTrId("wallet-txs-failed-max-offline"),
-        /*% "failed
+    set(DisplayStatus::FailedOffline, qtTrId("wallet-txs-failed-max-offline"));
+    /*% "failed
 public offline" */
-            qtTrId("wallet-txs-status-failed-public-offline"),
-            qtTrId("wallet-txs-status-failed")
-        );
-    }
-    else
-    {
-        //% "unknown"
-        return qtTrId("wallet-txs-status-unknown");
-    }
+    set(DisplayStatus::FailedPublicOffline, qtTrId("wallet-txs-status-failed-public-offline"));
+
+    //% "unknown"
+    set(DisplayStatus::Unknown, qtTrId("wallet-txs-status-unknown"));
+    return texts;
 }
 
 }  // namespace
 
 TxObjectList::TxObjectList()
+    : ListModel([](const auto& tx) { return tx->getTxID(); })
+    , m_statusTexts(buildStatusTexts())
+    , m_rowFactory([](const auto& tx) { return std::make_shared<TxObject>(tx); })
+    , m_searchIndex([this](const beam::wallet::TxID& txId)
+        {
+            const auto it = m_store.find(txId);
+            return it == m_store.end() ? QString() : TxObject::searchTextOf(*it->second);
+        })
+    , m_sortKeys({ static_cast<int>(Roles::TimeCreatedSort),
+                   static_cast<int>(Roles::AmountGeneralWithCurrencySort),
+                   static_cast<int>(Roles::AmountGeneralSort),
+                   static_cast<int>(Roles::AddressFromSort),
+                   static_cast<int>(Roles::AddressToSort),
+                   static_cast<int>(Roles::StatusSort) })
+    , m_displayValues({ static_cast<int>(Roles::TimeCreated),
+                        static_cast<int>(Roles::AmountGeneralWithCurrency),
+                        static_cast<int>(Roles::AmountGeneral),
+                        static_cast<int>(Roles::Rate),
+                        static_cast<int>(Roles::Fee),
+                        static_cast<int>(Roles::TxID) })
 {
     connect(&_amgr, &AssetsManager::assetInfo, this, &TxObjectList::onAssetInfo);
+    connect(&AppModel::getInstance().getSettings(), &WalletSettings::localeChanged, this, &TxObjectList::onLocaleChanged);
 }
 
 QHash<int, QByteArray> TxObjectList::roleNames() const
@@ -242,6 +195,15 @@ QVariant TxObjectList::data(const QModelIndex &index, int role) const
     }
     
     auto& value = m_list[index.row()];
+    if (m_displayValues.hasRole(role))
+    {
+        return m_displayValues.get(value->getTxID(), role, [&] () { return roleValue(value, role); });
+    }
+    return roleValue(value, role);
+}
+
+QVariant TxObjectList::roleValue(const std::shared_ptr<TxObject>& value, int role) const
+{
     switch (static_cast<Roles>(role))
     {
         case Roles::TimeCreated:
@@ -273,8 +235,9 @@ QVariant TxObjectList::data(const QModelIndex &index, int role) const
         case Roles::AddressToSort:
             return value->getAddressTo();
         case Roles::Status:
+            return m_statusTexts[static_cast<size_t>(value->getDisplayStatus())];
         case Roles::StatusSort:
-            return getStatusTextTranslated(value->getStatus(), value->getAddressType());
+            return static_cast<int>(value->getDisplayStatus());
         case Roles::Fee:
             return value->getFee();
         case Roles::Comment:
@@ -321,25 +284,12 @@ QVariant TxObjectList::data(const QModelIndex &index, int role) const
             return value->hasPaymentProof();
         case Roles::RawTxID:
             return QVariant::fromValue(value->getTxID());
-        case Roles::Search: 
-        {
-            QString r = value->getTransactionID();
-            r.append(" ");
-            r.append(value->getKernelID());
-            r.append(" ");
-            r.append(value->getAddressFrom());
-            r.append(" ");
-            r.append(value->getAddressTo());
-            r.append(" ");
-            r.append(value->getComment());
-            r.append(" ");
-            r.append(value->getSenderIdentity());
-            r.append(" ");
-            r.append(value->getReceiverIdentity());
-            r.append(" ");
-            r.append(value->getToken());
-            return r;
-        }
+        case Roles::Search:
+            if (const auto it = m_store.find(value->getTxID()); it != m_store.end())
+            {
+                return TxObject::searchTextOf(*it->second);
+            }
+            return QString();
         case Roles::StateDetails:
             return value->getStateDetails();
         case Roles::Token:
@@ -357,12 +307,477 @@ QVariant TxObjectList::data(const QModelIndex &index, int role) const
     }
 }
 
-void TxObjectList::onAssetInfo(beam::Asset::ID assetId)
+void TxObjectList::setPaged(int pageSize, RowFactory factory)
+{
+    m_pageSize = pageSize;
+    m_rowFactory = std::move(factory);
+}
+
+auto TxObjectList::unloadedKey(const beam::wallet::TxDescription& tx) -> TimeKey
+{
+    return { tx.m_createTime, tx.m_txId };
+}
+
+std::vector<std::shared_ptr<TxObject>> TxObjectList::takeNewest(size_t count, bool keepRows)
 {
-    for (auto it = m_list.begin(); it != m_list.end(); ++it) {
-        if ((*it)->getAssetId() == assetId) {
-           const auto idx = it - m_list.begin();
-           ListModel::touch(idx);
+    std::vector<std::shared_ptr<TxObject>> rows;
+    rows.reserve(std::min(count, m_unloaded.size()));
+    while (count-- && !m_unloaded.empty())
+    {
+        auto newest = std::prev(m_unloaded.end());
+        const auto row = keepRows ? rowOf(newest->first.second) : -1;
+        rows.push_back(row >= 0 ? m_list[row] : m_rowFactory(*newest->second));
+        m_unloaded.erase(newest);
+    }
+    return rows;
+}
+
+void TxObjectList::applyChanges(beam::wallet::ChangeAction action, const WalletModel::TxList& items)
+{
+    using namespace beam::wallet;
+
+    switch (action)
+    {
+        case ChangeAction::Reset:
+            {
+                m_store.clear();
+                m_searchIndex.clear();
+                m_byStatus.clear();
+                m_byAsset.clear();
+                for (auto& direction : m_byDirection)
+                {
+                    direction.clear();
+                }
+                for (const auto& tx : items)
+                {
+                    storeTx(tx);
+                }
+                fillSelection();
+
+                // keep as many rows as the view has already scrolled through
+                size_t count = m_pageSize > 0 ? size_t(std::max(m_pageSize, rowCount())) : m_unloaded.size();
+                reset(takeNewest(count));
+                break;
+            }
+
+        case ChangeAction::Removed:
+            {
+                std::vector<int> rows;
+                for (const auto& tx : items)
+                {
+                    if (auto it = m_store.find(tx->m_txId); it != m_store.end())
+                    {
+                        m_unloaded.erase(unloadedKey(*it->second));
+                        eraseTx(tx->m_txId);
+                    }
+                    auto row = rowOf(tx->m_txId);
+                    if (row >= 0)
+                    {
+                        rows.push_back(row);
+                    }
+                }
+                eraseRows(rows);
+                break;
+            }
+
+        case ChangeAction::Added:
+        case ChangeAction::Updated:
+            {
+                std::vector<int> stale;
+                std::vector<std::shared_ptr<TxObject>> rows;
+                for (const auto& tx : items)
+                {
+                    if (auto it = m_store.find(tx->m_txId); it != m_store.end())
+                    {
+                        m_unloaded.erase(unloadedKey(*it->second));
+                    }
+                    storeTx(tx);
+
+                    const auto row = rowOf(tx->m_txId);
+                    if (!isSelected(*tx))
+                    {
+                        if (row >= 0)
+                        {
+                            stale.push_back(row);
+                        }
+                        continue;
+                    }
+
+                    // rows older than the next page stay unloaded, history is fetched newest first
+                    const auto key = unloadedKey(*tx);
+                    if (row < 0 && !m_unloaded.empty() && key < std::prev(m_unloaded.end())->first)
+                    {
+                        m_unloaded.emplace(key, tx);
+                        continue;
+                    }
+                    rows.push_back(m_rowFactory(*tx));
+                }
+                eraseRows(stale);
+                update(rows);
+                break;
+            }
+
+        default:
+            assert(false && "Unexpected action");
+            break;
+    }
+}
+
+void TxObjectList::fetchAll()
+{
+    // other sort orders need every selected row
+    m_pageSize = 0;
+    insert(takeNewest(m_unloaded.size()));
+}
+
+void TxObjectList::fetchUntil(const beam::wallet::TxID& txId)
+{
+    const auto it = m_store.find(txId);
+    if (it == m_store.end())
+    {
+        return;
+    }
+    const auto unloaded = m_unloaded.find(unloadedKey(*it->second));
+    if (unloaded != m_unloaded.end())
+    {
+        insert(takeNewest(std::distance(unloaded, m_unloaded.end())));
+    }
+}
+
+void TxObjectList::select(const Filter& filter)
+{
+    m_filter = filter;
+    if (!m_filter.search.isEmpty() && !m_searchIndexed)
+    {
+        m_searchIndexed = true;
+        for (const auto& p : m_store)
+        {
+            m_searchIndex.set(p.first, TxObject::searchTextOf(*p.second));
         }
     }
+    fillSelection();
+    // rows which stay selected are up to date, only the newly selected ones are created
+    reset(takeNewest(m_pageSize > 0 ? size_t(m_pageSize) : m_unloaded.size(), true));
+}
+
+void TxObjectList::fillSelection()
+{
+    m_unloaded.clear();
+    auto add = [this](const WalletModel::TxPtr& tx)
+    {
+        if (isSelected(*tx))
+        {
+            m_unloaded.emplace(unloadedKey(*tx), tx);
+        }
+    };
+
+    const auto sets = candidates(m_filter);
+    if (sets.empty())
+    {
+        for (const auto& p : m_store)
+        {
+            add(p.second);
+        }
+        return;
+    }
+    for (const auto* set : sets)
+    {
+        for (const auto& txId : *set)
+        {
+            add(m_store.at(txId));
+        }
+    }
+}
+
+auto TxObjectList::candidates(const Filter& filter) const -> std::vector<const TxIDSet*>
+{
+    static const TxIDSet kNone;
+    auto indexed = [](const auto& index, const auto& key) -> const TxIDSet*
+    {
+        const auto it = index.find(key);
+        return it == index.end() ? &kNone : &it->second;
+    };
+
+    // empty when no predicate has an index, every stored transaction is a candidate then
+    std::vector<const TxIDSet*> best;
+    size_t bestSize = m_store.size();
+    auto consider = [&best, &bestSize](std::vector<const TxIDSet*> sets)
+    {
+        size_t size = 0;
+        for (const auto* set : sets)
+        {
+            size += set->size();
+        }
+        if (size <= bestSize)
+        {
+            bestSize = size;
+            best = std::move(sets);
+        }
+    };
+
+    if (!filter.statuses.empty())
+    {
+        std::vector<const TxIDSet*> sets;
+        for (auto status : filter.statuses)
+        {
+            sets.push_back(indexed(m_byStatus, status));
+        }
+        consider(std::move(sets));
+    }
+    if (filter.assetId >= 0)
+    {
+        consider({ indexed(m_byAsset, beam::Asset::ID(filter.assetId)) });
+    }
+    if (filter.direction != Filter::Direction::Any)
+    {
+        consider({ &m_byDirection[filter.direction == Filter::Direction::Outgoing] });
+    }
+    if (!filter.search.isEmpty())
+    {
+        consider({ &m_searchIndex.matching(filter.search) });
+    }
+    return best;
+}
+
+void TxObjectList::storeTx(const WalletModel::TxPtr& tx)
+{
+    auto& stored = m_store[tx->m_txId];
+    if (stored)
+    {
+        indexTx(*stored, false);
+    }
+    stored = tx;
+    indexTx(*tx, true);
+    if (m_searchIndexed)
+    {
+        m_searchIndex.set(tx->m_txId, TxObject::searchTextOf(*tx));
+    }
+}
+
+void TxObjectList::eraseTx(const beam::wallet::TxID& txId)
+{
+    if (auto it = m_store.find(txId); it != m_store.end())
+    {
+        indexTx(*it->second, false);
+        m_store.erase(it);
+        m_searchIndex.remove(txId);
+    }
+}
+
+void TxObjectList::indexTx(const beam::wallet::TxDescription& tx, bool add)
+{
+    auto change = [&tx, add](auto& index, const auto& key)
+    {
+        if (add)
+        {
+            index[key].insert(tx.m_txId);
+        }
+        else if (auto it = index.find(key); it != index.end())
+        {
+            it->second.erase(tx.m_txId);
+            if (it->second.empty())
+            {
+                index.erase(it);
+            }
+        }
+    };
+    change(m_byStatus, tx.m_status);
+    change(m_byAsset, tx.m_assetId);
+    if (add)
+    {
+        m_byDirection[tx.m_sender].insert(tx.m_txId);
+    }
+    else
+    {
+        m_byDirection[tx.m_sender].erase(tx.m_txId);
+    }
+}
+
+bool TxObjectList::isSelected(const beam::wallet::TxDescription& tx) const
+{
+    return matches(tx, m_filter) && (m_filter.search.isEmpty() || m_searchIndex.contains(tx.m_txId, m_filter.search));
+}
+
+bool TxObjectList::matches(const beam::wallet::TxDescription& tx, const Filter& filter)
+{
+    if (!filter.statuses.empty() &&
+        std::find(filter.statuses.begin(), filter.statuses.end(), tx.m_status) == filter.statuses.end())
+    {
+        return false;
+    }
+    if ((filter.direction == Filter::Direction::Incoming && tx.m_sender) ||
+        (filter.direction == Filter::Direction::Outgoing && !tx.m_sender))
+    {
+        return false;
+    }
+    if (filter.assetId >= 0 && tx.m_assetId != beam::Asset::ID(filter.assetId))
+    {
+        return false;
+    }
+    if ((filter.shieldedOnly && tx.m_txType != beam::wallet::TxType::PushTransaction) ||
+        (filter.offlineOnly && TxObject::addressTypeOf(tx) != beam::wallet::TxAddressType::Offline))
+    {
+        return false;
+    }
+    if ((filter.createdFrom && tx.m_createTime < filter.createdFrom) ||
+        (filter.createdTo && tx.m_createTime > filter.createdTo))
+    {
+        return false;
+    }
+    return true;
+}
+
+bool TxObjectList::canFetchMore(const QModelIndex& parent) const
+{
+    return !parent.isValid() && !m_unloaded.empty();
+}
+
+void TxObjectList::fetchMore(const QModelIndex& parent)
+{
+    if (parent.isValid() || m_unloaded.empty())
+    {
+        return;
+    }
+    insert(takeNewest(m_pageSize > 0 ? m_pageSize : m_unloaded.size()));
+}
+
+bool TxObjectList::hasSortKey(int role) const
+{
+    return m_sortKeys.hasRole(role);
+}
+
+bool TxObjectList::sortKeyLess(int leftRow, int rightRow, int role) const
+{
+    return m_sortKeys.less(m_list[leftRow]->getTxID(), m_list[rightRow]->getTxID(), role);
+}
+
+void TxObjectList::itemStored(const std::shared_ptr<TxObject>& item)
+{
+    const auto txId = item->getTxID();
+    m_displayValues.remove(txId);
+    if (item->isHeightDependent())
+    {
+        m_heightDependent.insert(txId);
+    }
+    else
+    {
+        m_heightDependent.erase(txId);
+    }
+    m_sortKeys.set(txId,
+    {
+        SortKey::fromNumber(item->timeCreated()),
+        SortKey::fromNumber(item->getAmountValue()),
+        SortKey::fromNumber(item->getAmountValue()),
+        SortKey::fromText(item->getAddressFrom()),
+        SortKey::fromText(item->getAddressTo()),
+        SortKey::fromNumber(static_cast<quint64>(item->getDisplayStatus()))
+    });
+}
+
+void TxObjectList::itemErased(const std::shared_ptr<TxObject>& item)
+{
+    m_sortKeys.remove(item->getTxID());
+    m_displayValues.remove(item->getTxID());
+    m_heightDependent.erase(item->getTxID());
+}
+
+void TxObjectList::itemsCleared()
+{
+    m_sortKeys.clear();
+    m_displayValues.clear();
+    m_heightDependent.clear();
+}
+
+QVector<int> TxObjectList::changedRoles(const std::shared_ptr<TxObject>& prev, const std::shared_ptr<TxObject>& next) const
+{
+    QVector<int> roles;
+    auto add = [&roles](std::initializer_list<Roles> changed)
+    {
+        for (auto role : changed)
+        {
+            if (!roles.contains(static_cast<int>(role)))
+            {
+                roles.push_back(static_cast<int>(role));
+            }
+        }
+    };
+
+    const auto changes = prev->compare(*next);
+    if (changes & TxObject::StatusChanged)
+    {
+        add({ Roles::Status, Roles::StatusSort, Roles::StateDetails, Roles::FailureReason,
+              Roles::IsCancelAvailable, Roles::IsDeleteAvailable, Roles::IsInProgress, Roles::IsPending,
+              Roles::IsCompleted, Roles::IsCanceled, Roles::IsFailed, Roles::IsExpired,
+              Roles::IsSent, Roles::IsReceived, Roles::HasPaymentProof });
+    }
+    if (changes & TxObject::KernelChanged)
+    {
+        add({ Roles::KernelID, Roles::Search });
+    }
+    if (changes & TxObject::FailureChanged)
+    {
+        add({ Roles::FailureReason, Roles::IsExpired });
+    }
+    if (changes & TxObject::FeeChanged)
+    {
+        add({ Roles::Fee });
+    }
+    if (changes & TxObject::AddressChanged)
+    {
+        add({ Roles::AddressFrom, Roles::AddressFromSort, Roles::AddressTo, Roles::AddressToSort,
+              Roles::Token, Roles::SenderIdentity, Roles::ReceiverIdentity, Roles::Search,
+              Roles::IsOfflineToken, Roles::IsPublicOffline, Roles::IsMaxPrivacy,
+              Roles::Status, Roles::StatusSort });
+    }
+    if (changes & TxObject::StateChanged)
+    {
+        add({ Roles::StateDetails });
+    }
+    if (changes & TxObject::AmountChanged)
+    {
+        add({ Roles::AmountGeneralWithCurrency, Roles::AmountGeneralWithCurrencySort,
+              Roles::AmountGeneral, Roles::AmountGeneralSort, Roles::Rate });
+    }
+    if (changes & TxObject::CommentChanged)
+    {
+        add({ Roles::Comment, Roles::Search });
+    }
+    return roles;
+}
+
+void TxObjectList::onLocaleChanged()
+{
+    // Translator is connected first, the new translation is installed by now
+    m_statusTexts = buildStatusTexts();
+    m_locale = QLocale();
+    m_displayValues.invalidate(static_cast<int>(Roles::TimeCreated));
+    if (!m_list.isEmpty())
+    {
+        emit dataChanged(index(0), index(m_list.size() - 1), { static_cast<int>(Roles::Status), static_cast<int>(Roles::TimeCreated) });
+    }
+}
+
+void TxObjectList::onHeightChanged()
+{
+    touchRows(m_heightDependent, { static_cast<int>(Roles::StateDetails) });
+}
+
+void TxObjectList::onAssetInfo(beam::Asset::ID assetId)
+{
+    // only the unit name and the icon come from the asset info
+    const auto it = m_byAsset.find(assetId);
+    if (it == m_byAsset.end())
+    {
+        return;
+    }
+    for (const auto& txId : it->second)
+    {
+        m_displayValues.invalidate(txId, static_cast<int>(Roles::AmountGeneralWithCurrency));
+    }
+    touchRows(it->second,
+    {
+        static_cast<int>(Roles::AmountGeneralWithCurrency),
+        static_cast<int>(Roles::UnitName),
+        static_cast<int>(Roles::Icon)
+    });
 }
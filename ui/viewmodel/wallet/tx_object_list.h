@@ -16,10 +16,18 @@
 
 #include "tx_object.h"
 #include "viewmodel/helpers/list_model.h"
+#include "viewmodel/helpers/role_cache.h"
+#include "viewmodel/helpers/search_index.h"
+#include "viewmodel/helpers/sort_key.h"
 #include "assets_manager.h"
 #include <QLocale>
+#include <array>
+#include <map>
+#include <unordered_set>
+#include <vector>
 
-class TxObjectList : public ListModel<std::shared_ptr<TxObject>>
+class TxObjectList : public ListModel<std::shared_ptr<TxObject>, beam::wallet::TxID, RawKeyHash>
+                   , public SortKeyModel
 {
     Q_OBJECT
 public:
@@ -72,15 +80,100 @@ public:
 
     Q_ENUM(Roles)
 
+    using RowFactory = std::function<std::shared_ptr<TxObject>(const beam::wallet::TxDescription&)>;
+
+    // Typed predicates of TxFilterProxyModel, rows are created only for the transactions which match them
+    struct Filter
+    {
+        enum class Direction
+        {
+            Any,
+            Incoming,
+            Outgoing
+        };
+
+        std::vector<beam::wallet::TxStatus> statuses; // empty matches any status
+        Direction direction = Direction::Any;
+        int assetId = -1;
+        bool shieldedOnly = false;
+        bool offlineOnly = false;
+        beam::Timestamp createdFrom = 0; // 0 is not bounded
+        beam::Timestamp createdTo = 0;
+        QString search; // case folded, empty matches any transaction
+    };
+
     TxObjectList();
 
     QVariant data(const QModelIndex &index, int role) const override;
     QHash<int, QByteArray> roleNames() const override;
 
+    // Paged mode: rows are created newest first, one page at a time, as the view scrolls to them.
+    // Transactions of later pages are kept as pointers into the WalletModel store until then
+    void setPaged(int pageSize, RowFactory factory);
+    void applyChanges(beam::wallet::ChangeAction action, const WalletModel::TxList& items);
+    void fetchAll();
+    // loads the pages down to the transaction, if it is selected
+    void fetchUntil(const beam::wallet::TxID& txId);
+    // Replaces the rows with the transactions matching the filter. The candidates are taken from
+    // the smallest status, asset or direction index, so the cost follows the matching transactions
+    void select(const Filter& filter);
+
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+
+    bool hasSortKey(int role) const override;
+    bool sortKeyLess(int leftRow, int rightRow, int role) const override;
+
+public slots:
+    // only the rows counting down to a height are refreshed
+    void onHeightChanged();
+
+protected:
+    QVector<int> changedRoles(const std::shared_ptr<TxObject>& prev, const std::shared_ptr<TxObject>& next) const override;
+    void itemStored(const std::shared_ptr<TxObject>& item) override;
+    void itemErased(const std::shared_ptr<TxObject>& item) override;
+    void itemsCleared() override;
+
 private slots:
     void onAssetInfo(beam::Asset::ID assetId);
+    void onLocaleChanged();
 
 private:
+    using TimeKey = std::pair<beam::Timestamp, beam::wallet::TxID>;
+    using TxIDSet = std::unordered_set<beam::wallet::TxID, RawKeyHash>;
+
+    QVariant roleValue(const std::shared_ptr<TxObject>& value, int role) const;
+
+    static TimeKey unloadedKey(const beam::wallet::TxDescription& tx);
+    static bool matches(const beam::wallet::TxDescription& tx, const Filter& filter);
+    bool isSelected(const beam::wallet::TxDescription& tx) const;
+    std::vector<std::shared_ptr<TxObject>> takeNewest(size_t count, bool keepRows = false);
+
+    void storeTx(const WalletModel::TxPtr& tx);
+    void eraseTx(const beam::wallet::TxID& txId);
+    void indexTx(const beam::wallet::TxDescription& tx, bool add);
+    std::vector<const TxIDSet*> candidates(const Filter& filter) const;
+    void fillSelection();
+
     mutable AssetsManager _amgr;
     QLocale m_locale;
+    std::vector<QString> m_statusTexts;
+
+    int m_pageSize = 0;
+    RowFactory m_rowFactory;
+    Filter m_filter;
+    // every transaction of the list, rows exist only for the selected ones
+    std::unordered_map<beam::wallet::TxID, WalletModel::TxPtr, RawKeyHash> m_store;
+    std::map<beam::wallet::TxStatus, TxIDSet> m_byStatus;
+    std::map<beam::Asset::ID, TxIDSet> m_byAsset;
+    std::array<TxIDSet, 2> m_byDirection; // indexed by TxDescription::m_sender
+    // built on the first search, the texts are not made for the transactions before
+    SearchIndex<beam::wallet::TxID, RawKeyHash> m_searchIndex;
+    bool m_searchIndexed = false;
+    // selected transactions which have no rows yet
+    std::map<TimeKey, WalletModel::TxPtr> m_unloaded;
+    SortKeyCache<beam::wallet::TxID, RawKeyHash> m_sortKeys;
+    mutable RoleValueCache<beam::wallet::TxID, RawKeyHash> m_displayValues;
+
+    TxIDSet m_heightDependent;
 };
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include "tx_table.h"
+#include "model/event_monitor.h"
 #include <QFileDialog>
 #include <QStandardPaths>
 #include <QDateTime>
@@ -25,6 +26,7 @@ namespace
     const char kTxHistoryFileNamePrefix[] = "transactions_history_";
     const char kTxHistoryFileFormatDesc[] = "Comma-Separated Values (*.csv)";
     const char kTxHistoryFileNameFormat[] = "yyyy_MM_dd_HH_mm_ss";
+    const int kTxPageSize = 100;
 }
 
 TxTableViewModel::TxTableViewModel()
@@ -33,8 +35,22 @@ TxTableViewModel::TxTableViewModel()
     connect(&_model, SIGNAL(transactionsChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>&)), SLOT(onTransactionsChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>&)));
     connect(&_model, SIGNAL(txHistoryExportedToCsv(const QString&)), this, SLOT(onTxHistoryExportedToCsv(const QString&)));
     connect(&_exchangeRatesManager, &ExchangeRatesManager::rateUnitChanged, this, &TxTableViewModel::rateChanged);
+    connect(&_model, &WalletModel::heightChanged, &_transactionsList, &TxObjectList::onHeightChanged);
     connect(&_exchangeRatesManager, &ExchangeRatesManager::activeRateChanged, this, &TxTableViewModel::rateChanged);
-    _model.getAsync()->getTransactions();
+
+    _transactionsList.setPaged(kTxPageSize, [this] (const beam::wallet::TxDescription& tx)
+    {
+        return std::make_shared<TxObject>(tx, _exchangeRatesManager.getRateUnitRaw());
+    });
+
+    if (_model.isTransactionsLoaded())
+    {
+        applyTransactions(beam::wallet::ChangeAction::Reset, _model.getTransactions(WalletModel::TxKind::Simple));
+    }
+    else
+    {
+        _model.loadTransactions();
+    }
 }
 
 void TxTableViewModel::exportTxHistoryToCsv()
@@ -78,73 +94,30 @@ QAbstractItemModel* TxTableViewModel::getTransactions()
 
 void TxTableViewModel::onTransactionsChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& transactions)
 {
-    using namespace beam::wallet;
+    EventMonitor::Scope monitorScope("TxTableViewModel::onTransactionsChanged");
+    applyTransactions(action, _model.getTransactions(transactions, WalletModel::TxKind::Simple));
+}
 
-    std::vector<std::shared_ptr<TxObject>> modifiedTransactions;
-    modifiedTransactions.reserve(transactions.size());
-    ExchangeRate::Currency secondCurrency = _exchangeRatesManager.getRateUnitRaw();
+void TxTableViewModel::applyTransactions(beam::wallet::ChangeAction action, const WalletModel::TxList& items)
+{
+    _transactionsList.applyChanges(action, items);
+    emit transactionsChanged();
+}
 
-    for (const auto& t : transactions)
-    {
-        if(const auto txType = t.GetParameter<TxType>(TxParameterID::TransactionType))
-        {
-            switch(*txType)
-            {
-            case TxType::AtomicSwap:
-            case TxType::AssetIssue:
-            case TxType::AssetConsume:
-            case TxType::AssetReg:
-            case TxType::AssetUnreg:
-            case TxType::AssetInfo:
-            case TxType::PullTransaction:
-            case TxType::UnlinkFunds:
-            case TxType::VoucherRequest:
-            case TxType::VoucherResponse:
-            case TxType::Contract:
-                continue;
-            case TxType::ALL:
-                assert(!"This should not happen");
-                continue;
-            case TxType::PushTransaction:
-            case TxType::Simple:
-                break;
-            }
-            modifiedTransactions.push_back(std::make_shared<TxObject>(t, secondCurrency));
-        }
-    }
+void TxTableViewModel::loadAllTransactions()
+{
+    _transactionsList.fetchAll();
+}
 
-    switch (action)
+void TxTableViewModel::loadTransactionsUntil(const QString& txId)
+{
+    const auto buffer = beam::from_hex(txId.toStdString());
+    beam::wallet::TxID id;
+    if (buffer.size() == id.size())
     {
-        case ChangeAction::Reset:
-            {
-                _transactionsList.reset(modifiedTransactions);
-                break;
-            }
-
-        case ChangeAction::Removed:
-            {
-                _transactionsList.remove(modifiedTransactions);
-                break;
-            }
-
-        case ChangeAction::Added:
-            {
-                _transactionsList.insert(modifiedTransactions);
-                break;
-            }
-
-        case ChangeAction::Updated:
-            {
-                _transactionsList.update(modifiedTransactions);
-                break;
-            }
-
-        default:
-            assert(false && "Unexpected action");
-            break;
+        std::copy(buffer.begin(), buffer.end(), id.begin());
+        _transactionsList.fetchUntil(id);
     }
-
-    emit transactionsChanged();
 }
 
 QString TxTableViewModel::getRateUnit() const
@@ -38,6 +38,8 @@ public:
     Q_INVOKABLE void cancelTx(const QVariant& variantTxID);
     Q_INVOKABLE void deleteTx(const QVariant& variantTxID);
     Q_INVOKABLE PaymentInfoItem* getPaymentInfo(const QVariant& variantTxID);
+    Q_INVOKABLE void loadAllTransactions();
+    Q_INVOKABLE void loadTransactionsUntil(const QString& txId);
 
 public slots:
     void onTxHistoryExportedToCsv(const QString& data);
@@ -48,6 +50,8 @@ signals:
     void rateChanged();
 
 private:
+    void applyTransactions(beam::wallet::ChangeAction action, const WalletModel::TxList& items);
+
     WalletModel&         _model;
     QQueue<QString>      _txHistoryToCsvPaths;
     TxObjectList         _transactionsList;